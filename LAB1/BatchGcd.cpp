@@ -0,0 +1,61 @@
+#include "BatchGcd.hpp"
+#include <stdexcept>
+#include "Parallel.hpp"
+
+// parallelFor over a tree level, or a plain loop when the level is too small
+// to pay for the threads. Levels near the root have only one or two nodes;
+// their cores come from the threaded Karatsuba inside operator*.
+template<typename F>
+static void forLevel(size_t count, size_t words, F f) {
+    if (words >= PARALLEL_LEVEL_WORDS) parallelFor(count, f);
+    else for (size_t i = 0; i < count; ++i) f(i);
+}
+
+static size_t totalWords(const std::vector<BigUInt>& level) {
+    size_t words = 0;
+    for (const BigUInt& v : level) words += v.words().size();
+    return words;
+}
+
+std::vector<BigUInt> batchGcd(std::span<const BigUInt> moduli) {
+    if (moduli.empty()) return {};
+    for (const BigUInt& n : moduli) {
+        if (n == BigUInt(0)) throw std::runtime_error("Batch GCD moduli must be non-zero");
+    }
+
+    // tree[0] holds the moduli, tree.back() the single product. An odd
+    // element at the end of a level is carried up unchanged.
+    std::vector<std::vector<BigUInt>> tree;
+    tree.emplace_back(moduli.begin(), moduli.end());
+    while (tree.back().size() > 1) {
+        const std::vector<BigUInt>& level = tree.back();
+        std::vector<BigUInt> next((level.size() + 1) / 2);
+        forLevel(next.size(), totalWords(level), [&](size_t i) {
+            next[i] = (2 * i + 1 < level.size()) ? level[2 * i] * level[2 * i + 1] : level[2 * i];
+            });
+        tree.push_back(std::move(next));
+    }
+
+    // Walk back down: each node keeps its parent's remainder modulo its own square.
+    std::vector<BigUInt> rem = tree.back();
+    for (size_t l = tree.size() - 1; l-- > 0;) {
+        const std::vector<BigUInt>& level = tree[l];
+        std::vector<BigUInt> next(level.size());
+        forLevel(level.size(), 3 * totalWords(level), [&](size_t i) {
+            next[i] = rem[i / 2] % (level[i] * level[i]);
+            });
+        rem.swap(next);
+    }
+
+    std::vector<BigUInt> result(moduli.size());
+    forLevel(moduli.size(), 3 * totalWords(tree[0]), [&](size_t i) {
+        result[i] = BigUInt::gcd(moduli[i], rem[i] / moduli[i]);
+        });
+    return result;
+}
+
+std::vector<BigUInt> batchGcd(const MappedBigUIntArray& moduli) {
+    std::vector<BigUInt> values(moduli.size());
+    parallelFor(moduli.size(), [&](size_t i) { values[i] = moduli.at(i); });
+    return batchGcd(values);
+}
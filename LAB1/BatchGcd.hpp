@@ -0,0 +1,18 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include "BigUInt.hpp"
+#include "BigUIntArray.hpp"
+
+// Bernstein's batch GCD. For every modulus n_i returns
+// gcd(n_i, product of all other moduli), so any result other than 1 flags a
+// modulus that shares a factor with another one in the set.
+//
+// Builds a product tree over the moduli, pushes P = prod(n_i) down a
+// remainder tree (P mod n_i^2 at the leaves) and finishes with
+// gcd(n_i, (P mod n_i^2) / n_i). Wide levels are split across threads by
+// node; the narrow levels near the root get theirs from the threaded
+// Karatsuba multiply that both the products and the divisions go through.
+std::vector<BigUInt> batchGcd(std::span<const BigUInt> moduli);
+std::vector<BigUInt> batchGcd(const MappedBigUIntArray& moduli);
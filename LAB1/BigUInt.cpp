@@ -1,8 +1,18 @@
 ﻿#include "BigUInt.hpp"
+#include "Limbs.hpp"
+#include "ModInt.hpp"
+#include "Parallel.hpp"
+#include "ReductionCache.hpp"
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <cctype>
 #include <cmath>
+#include <bit>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 const uint64_t BASE = 4294967296ULL;
 
@@ -33,6 +43,7 @@ BigUInt::BigUInt(const std::string& str) {
     }
 
     if (isHex) {
+        if (s.empty()) s = "0";
         while (s.length() % 8 != 0) s = "0" + s;
         for (size_t i = 0; i < s.length(); i += 8) {
             std::string block = s.substr(s.length() - 8 - i, 8);
@@ -62,6 +73,13 @@ BigUInt::BigUInt(const std::string& str) {
     stripZeros();
 }
 
+bool BigUInt::isNumber(const std::string& str) {
+    if (str.size() >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+        return str.size() > 2 && std::all_of(str.begin() + 2, str.end(), [](unsigned char ch) { return std::isxdigit(ch) != 0; });
+    }
+    return !str.empty() && std::all_of(str.begin(), str.end(), [](unsigned char ch) { return std::isdigit(ch) != 0; });
+}
+
 void BigUInt::stripZeros() {
     while (digits.size() > 1 && digits.back() == 0) {
         digits.pop_back();
@@ -113,41 +131,203 @@ BigUInt BigUInt::operator*(const BigUInt& other) const {
     if (*this == BigUInt(0) || other == BigUInt(0)) return BigUInt(0);
     BigUInt res;
     res.digits.resize(digits.size() + other.digits.size(), 0);
+    mulLimbs(digits.data(), digits.size(), other.digits.data(), other.digits.size(), res.digits.data());
+    res.stripZeros();
+    return res;
+}
 
-    for (size_t i = 0; i < digits.size(); ++i) {
+// Knuth, TAOCP vol. 2, 4.3.1, Algorithm D. u and v are stripped, v has at
+// least two words and u >= v. Writes the remainder to r and, if q is not
+// null, the quotient to q.
+void BigUInt::divModKnuth(const std::vector<uint32_t>& u, const std::vector<uint32_t>& v,
+    std::vector<uint32_t>* q, std::vector<uint32_t>& r) {
+    size_t m = v.size();
+    size_t len = u.size();
+    int s = std::countl_zero(v.back());
+
+    std::vector<uint32_t> vn(m), un(len + 1);
+    for (size_t i = m - 1; i > 0; --i) {
+        vn[i] = (v[i] << s) | (s ? static_cast<uint32_t>(static_cast<uint64_t>(v[i - 1]) >> (32 - s)) : 0);
+    }
+    vn[0] = v[0] << s;
+    un[len] = s ? static_cast<uint32_t>(static_cast<uint64_t>(u[len - 1]) >> (32 - s)) : 0;
+    for (size_t i = len - 1; i > 0; --i) {
+        un[i] = (u[i] << s) | (s ? static_cast<uint32_t>(static_cast<uint64_t>(u[i - 1]) >> (32 - s)) : 0);
+    }
+    un[0] = u[0] << s;
+
+    if (q) q->assign(len - m + 1, 0);
+    uint64_t vTop = vn[m - 1], vNext = vn[m - 2];
+
+    for (size_t j = len - m + 1; j-- > 0;) {
+        uint64_t num = (static_cast<uint64_t>(un[j + m]) << 32) | un[j + m - 1];
+        uint64_t qhat = num / vTop;
+        uint64_t rhat = num % vTop;
+        while (qhat >= BASE || qhat * vNext > ((rhat << 32) | un[j + m - 2])) {
+            --qhat;
+            rhat += vTop;
+            if (rhat >= BASE) break;
+        }
+
+        int64_t borrow = 0;
         uint64_t carry = 0;
-        for (size_t j = 0; j < other.digits.size() || carry; ++j) {
-            uint64_t cur = res.digits[i + j] +
-                static_cast<uint64_t>(digits[i]) * (j < other.digits.size() ? other.digits[j] : 0) +
-                carry;
-            res.digits[i + j] = static_cast<uint32_t>(cur);
-            carry = cur >> 32;
+        for (size_t i = 0; i < m; ++i) {
+            uint64_t p = qhat * vn[i] + carry;
+            carry = p >> 32;
+            int64_t t = static_cast<int64_t>(un[i + j]) - static_cast<uint32_t>(p) - borrow;
+            un[i + j] = static_cast<uint32_t>(t);
+            borrow = t < 0;
+        }
+        int64_t t = static_cast<int64_t>(un[j + m]) - static_cast<int64_t>(carry) - borrow;
+        un[j + m] = static_cast<uint32_t>(t);
+
+        if (t < 0) {
+            --qhat;
+            uint64_t c = 0;
+            for (size_t i = 0; i < m; ++i) {
+                uint64_t sum = static_cast<uint64_t>(un[i + j]) + vn[i] + c;
+                un[i + j] = static_cast<uint32_t>(sum);
+                c = sum >> 32;
+            }
+            un[j + m] += static_cast<uint32_t>(c);
         }
+        if (q) (*q)[j] = static_cast<uint32_t>(qhat);
+    }
+
+    r.assign(m, 0);
+    for (size_t i = 0; i < m; ++i) {
+        r[i] = (un[i] >> s) | (s ? static_cast<uint32_t>(static_cast<uint64_t>(un[i + 1]) << (32 - s)) : 0);
+    }
+}
+
+// Burnikel-Ziegler recursive division, "Fast Recursive Division" (1998).
+// Long divisions are split into half-size subproblems whose cost is
+// dominated by multiplications, so they inherit the Karatsuba speedup.
+
+// Divisors longer than this many words are divided recursively.
+static const size_t BZ_THRESHOLD = 64;
+
+BigUInt BigUInt::wordSlice(size_t from, size_t count) const {
+    BigUInt res;
+    if (from < digits.size()) {
+        size_t to = std::min(digits.size(), from + count);
+        res.digits.assign(digits.begin() + from, digits.begin() + to);
+        res.stripZeros();
     }
-    res.stripZeros();
     return res;
 }
 
+void BigUInt::shiftLeftWords(size_t words) {
+    if (words == 0 || (digits.size() == 1 && digits[0] == 0)) return;
+    digits.insert(digits.begin(), words, 0);
+}
+
+// a < b * B^n, b has exactly n words and its top bit set.
+void BigUInt::divTwoByOne(const BigUInt& a, const BigUInt& b, size_t n, BigUInt& q, BigUInt& r) {
+    if (n % 2 != 0 || n <= BZ_THRESHOLD) {
+        divMod(a, b, q, r);
+        return;
+    }
+    size_t half = n / 2;
+    BigUInt q1, r1, q0;
+    divThreeByTwo(a.wordSlice(half, 3 * half), b, half, q1, r1);
+    r1.shiftLeftWords(half);
+    divThreeByTwo(r1 + a.wordSlice(0, half), b, half, q0, r);
+    q1.shiftLeftWords(half);
+    q = q1 + q0;
+}
+
+// a < b * B^half, b has exactly 2 * half words and its top bit set.
+void BigUInt::divThreeByTwo(const BigUInt& a, const BigUInt& b, size_t half, BigUInt& q, BigUInt& r) {
+    BigUInt b1 = b.wordSlice(half, half);
+    BigUInt b2 = b.wordSlice(0, half);
+    BigUInt a12 = a.wordSlice(half, 2 * half);
+
+    BigUInt qhat, r1;
+    if (a.wordSlice(2 * half, half) < b1) {
+        divTwoByOne(a12, b1, half, qhat, r1);
+    }
+    else {
+        // qhat = B^half - 1, and a12 - qhat * b1 = a12 - b1 * B^half + b1.
+        qhat.digits.assign(half, 0xFFFFFFFF);
+        BigUInt b1Shifted = b1;
+        b1Shifted.shiftLeftWords(half);
+        r1 = (a12 + b1) - b1Shifted;
+    }
+
+    BigUInt d = qhat * b2;
+    r1.shiftLeftWords(half);
+    BigUInt rhat = r1 + a.wordSlice(0, half);
+    while (rhat < d) {
+        qhat = qhat - BigUInt(1);
+        rhat = rhat + b;
+    }
+    r = rhat - d;
+    q = std::move(qhat);
+}
+
+// Normalizes b to n = j * 2^k words (j <= BZ_THRESHOLD) and runs a long
+// division of a in base B^n, one divTwoByOne per quotient block.
+void BigUInt::divModRecursive(const BigUInt& a, const BigUInt& b, BigUInt& quotient, BigUInt& remainder) {
+    size_t s = b.digits.size();
+    size_t m = 1;
+    while (m * BZ_THRESHOLD <= s) m <<= 1;
+    size_t n = ((s + m - 1) / m) * m;
+    int sigma = static_cast<int>(n * 32) - b.bitLength();
+
+    BigUInt bn = b << sigma;
+    BigUInt an = a << sigma;
+    size_t blockBits = n * 32;
+    size_t t = std::max<size_t>(2, (static_cast<size_t>(an.bitLength()) + blockBits) / blockBits);
+
+    BigUInt q;
+    q.digits.assign((t - 1) * n, 0);
+    BigUInt z = an.wordSlice((t - 2) * n, 2 * n);
+    BigUInt qi, ri;
+    for (size_t i = t - 1; i-- > 0;) {
+        divTwoByOne(z, bn, n, qi, ri);
+        std::copy(qi.digits.begin(), qi.digits.end(), q.digits.begin() + i * n);
+        if (i > 0) {
+            ri.shiftLeftWords(n);
+            z = ri + an.wordSlice((i - 1) * n, n);
+        }
+    }
+    q.stripZeros();
+    quotient = std::move(q);
+    remainder = ri >> sigma;
+}
+
 void BigUInt::divMod(const BigUInt& dividend, const BigUInt& divisor, BigUInt& quotient, BigUInt& remainder) {
     if (divisor == BigUInt(0)) throw std::runtime_error("Division by zero");
     if (dividend < divisor) {
-        quotient = BigUInt(0);
         remainder = dividend;
+        quotient = BigUInt(0);
         return;
     }
-    quotient = BigUInt(0);
-    remainder = BigUInt(0);
 
-    for (int i = dividend.bitLength() - 1; i >= 0; --i) {
-        remainder.shiftLeft(1);
-        if (dividend.getBit(i)) remainder.digits[0] |= 1;
-        if (remainder >= divisor) {
-            remainder = remainder - divisor;
-            quotient.setBit(i);
+    BigUInt q, r;
+    if (divisor.digits.size() == 1) {
+        uint64_t d = divisor.digits[0];
+        uint64_t rem = 0;
+        q.digits.assign(dividend.digits.size(), 0);
+        for (size_t i = dividend.digits.size(); i-- > 0;) {
+            uint64_t cur = (rem << 32) | dividend.digits[i];
+            q.digits[i] = static_cast<uint32_t>(cur / d);
+            rem = cur % d;
         }
+        r.digits.assign(1, static_cast<uint32_t>(rem));
     }
-    quotient.stripZeros();
-    remainder.stripZeros();
+    else if (divisor.digits.size() > BZ_THRESHOLD && dividend.digits.size() - divisor.digits.size() > BZ_THRESHOLD) {
+        divModRecursive(dividend, divisor, quotient, remainder);
+        return;
+    }
+    else {
+        divModKnuth(dividend.digits, divisor.digits, &q.digits, r.digits);
+    }
+    q.stripZeros();
+    r.stripZeros();
+    quotient = std::move(q);
+    remainder = std::move(r);
 }
 
 BigUInt BigUInt::operator/(const BigUInt& other) const {
@@ -186,15 +366,220 @@ BigUInt BigUInt::lcm(const BigUInt& a, const BigUInt& b) {
 
 BigUInt BigUInt::powMod(const BigUInt& exponent, const BigUInt& modulus) const {
     if (modulus == BigUInt(0)) throw std::runtime_error("Modulo by zero");
+
+    // Multi-word moduli take their contexts from the shared cache so repeated
+    // moduli skip the setup: special forms fold, odd moduli run in Montgomery form.
+    if (modulus.digits.size() > 1) {
+        std::shared_ptr<const ReductionContext> ctx = ReductionCache::global().get(modulus);
+        if (ctx->special) return ctx->special->powMod(*this, exponent);
+        if (ctx->montgomery) return ModInt(ctx->montgomery, *this).pow(exponent).toBigUInt();
+    }
+
     BigUInt res(1);
     BigUInt base = *this % modulus;
     for (int i = 0; i < exponent.bitLength(); ++i) {
-        if (exponent.getBit(i)) res = (res * base) % modulus;
-        base = (base * base) % modulus;
+        if (exponent.getBit(i)) res = mulMod(res, base, modulus);
+        base = sqrMod(base, modulus);
     }
     return res;
 }
 
+// Products
+
+BigUInt BigUInt::product(std::span<const BigUInt> values) {
+    if (values.empty()) return BigUInt(1);
+    std::vector<BigUInt> level(values.begin(), values.end());
+
+    while (level.size() > 1) {
+        size_t pairs = level.size() / 2;
+        std::vector<BigUInt> next(pairs + level.size() % 2);
+        size_t words = 0;
+        for (const BigUInt& v : level) words += v.digits.size();
+
+        auto mulPair = [&](size_t i) { next[i] = level[2 * i] * level[2 * i + 1]; };
+        if (words >= PARALLEL_LEVEL_WORDS) parallelFor(pairs, mulPair);
+        else for (size_t i = 0; i < pairs; ++i) mulPair(i);
+
+        if (level.size() % 2) next.back() = std::move(level.back());
+        level.swap(next);
+    }
+    return level[0];
+}
+
+static std::vector<uint32_t> primesUpTo(uint32_t n) {
+    std::vector<uint32_t> primes;
+    if (n < 2) return primes;
+    std::vector<bool> composite(static_cast<size_t>(n) + 1, false);
+    for (uint64_t i = 2; i <= n; ++i) {
+        if (composite[i]) continue;
+        primes.push_back(static_cast<uint32_t>(i));
+        for (uint64_t j = i * i; j <= n; j += i) composite[j] = true;
+    }
+    return primes;
+}
+
+// Packs the prime powers p^e into 64-bit leaves so the product tree starts
+// from as few leaves as possible.
+namespace {
+class FactorCollector {
+public:
+    void add(uint64_t p, uint64_t e) {
+        for (; e > 0; --e) {
+            if (acc > UINT64_MAX / p) { leaves.push_back(BigUInt(acc)); acc = 1; }
+            acc *= p;
+        }
+    }
+
+    BigUInt product() {
+        if (acc > 1) leaves.push_back(BigUInt(acc));
+        acc = 1;
+        return BigUInt::product(leaves);
+    }
+
+private:
+    std::vector<BigUInt> leaves;
+    uint64_t acc = 1;
+};
+}
+
+// swing(n) = n! / (floor(n/2)!)^2; prime p divides it with exponent
+// sum over i of (floor(n / p^i) mod 2).
+static BigUInt primeSwing(uint32_t n, const std::vector<uint32_t>& primes) {
+    FactorCollector factors;
+    for (uint32_t p : primes) {
+        if (p > n) break;
+        uint64_t e = 0;
+        for (uint64_t q = n / p; q > 0; q /= p) e += q & 1;
+        factors.add(p, e);
+    }
+    return factors.product();
+}
+
+static BigUInt factorialSwing(uint32_t n, const std::vector<uint32_t>& primes) {
+    if (n < 2) return BigUInt(1);
+    BigUInt half = factorialSwing(n / 2, primes);
+    return half * half * primeSwing(n, primes);
+}
+
+BigUInt BigUInt::factorial(uint32_t n) {
+    return factorialSwing(n, primesUpTo(n));
+}
+
+// Legendre: p divides C(n, k) with exponent
+// sum over i of floor(n/p^i) - floor(k/p^i) - floor((n-k)/p^i).
+BigUInt BigUInt::binomial(uint32_t n, uint32_t k) {
+    if (k > n) return BigUInt(0);
+    k = std::min(k, n - k);
+    if (k == 0) return BigUInt(1);
+
+    FactorCollector factors;
+    for (uint32_t p : primesUpTo(n)) {
+        uint64_t e = 0;
+        for (uint64_t pi = p; pi <= n; pi *= p) e += n / pi - k / pi - (n - k) / pi;
+        factors.add(p, e);
+    }
+    return factors.product();
+}
+
+// Modular primitives
+
+static int compareWords(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    size_t na = a.size(), nb = b.size();
+    while (na > 0 && a[na - 1] == 0) --na;
+    while (nb > 0 && b[nb - 1] == 0) --nb;
+    if (na != nb) return na > nb ? 1 : -1;
+    for (size_t i = na; i-- > 0;) {
+        if (a[i] != b[i]) return a[i] > b[i] ? 1 : -1;
+    }
+    return 0;
+}
+
+// a -= b, requires a >= b.
+static void subWords(std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    subLimbs(a.data(), a.size(), b.data(), b.size());
+}
+
+// a += b, growing a when the sum carries out.
+static void addWords(std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+    if (a.size() < b.size()) a.resize(b.size(), 0);
+    if (addLimbs(a.data(), a.size(), b.data(), b.size())) a.push_back(1);
+}
+
+// Reduces x modulo n in place. Single-word moduli take a 64-bit Horner pass,
+// moduli of the form 2^k - c fold through their cached context, and all
+// others use a remainder-only Algorithm D.
+void BigUInt::reduce(std::vector<uint32_t>& x, const BigUInt& n) {
+    while (x.size() > 1 && x.back() == 0) x.pop_back();
+    if (compareWords(x, n.digits) < 0) return;
+
+    // The word test is exact, so only special moduli ever reach the cache.
+    if (PseudoMersenneContext::hasSpecialForm(n.digits)) {
+        ReductionCache::global().get(n)->special->reduce(x);
+        return;
+    }
+
+    if (n.digits.size() == 1) {
+        uint64_t d = n.digits[0];
+        uint64_t rem = 0;
+        for (size_t i = x.size(); i-- > 0;) rem = ((rem << 32) | x[i]) % d;
+        x.assign(1, static_cast<uint32_t>(rem));
+        return;
+    }
+    std::vector<uint32_t> r;
+    divModKnuth(x, n.digits, nullptr, r);
+    x.swap(r);
+    while (x.size() > 1 && x.back() == 0) x.pop_back();
+}
+
+BigUInt BigUInt::mulAdd(const BigUInt& a, const BigUInt& b, const BigUInt& c) {
+    BigUInt res;
+    res.digits.assign(std::max(a.digits.size() + b.digits.size(), c.digits.size()) + 1, 0);
+    mulLimbs(a.digits.data(), a.digits.size(), b.digits.data(), b.digits.size(), res.digits.data());
+    addLimbs(res.digits.data(), res.digits.size(), c.digits.data(), c.digits.size());
+    res.stripZeros();
+    return res;
+}
+
+BigUInt BigUInt::mulMod(const BigUInt& a, const BigUInt& b, const BigUInt& n) {
+    if (n == BigUInt(0)) throw std::runtime_error("Modulo by zero");
+    BigUInt res;
+    mulLimbs(a.digits, b.digits, res.digits);
+    reduce(res.digits, n);
+    return res;
+}
+
+BigUInt BigUInt::sqrMod(const BigUInt& a, const BigUInt& n) {
+    if (n == BigUInt(0)) throw std::runtime_error("Modulo by zero");
+    BigUInt res;
+    sqrLimbs(a.digits, res.digits);
+    reduce(res.digits, n);
+    return res;
+}
+
+BigUInt BigUInt::addMod(const BigUInt& a, const BigUInt& b, const BigUInt& n) {
+    if (n == BigUInt(0)) throw std::runtime_error("Modulo by zero");
+    BigUInt res = a;
+    reduce(res.digits, n);
+    std::vector<uint32_t> rb = b.digits;
+    reduce(rb, n);
+    addWords(res.digits, rb);
+    if (compareWords(res.digits, n.digits) >= 0) subWords(res.digits, n.digits);
+    res.stripZeros();
+    return res;
+}
+
+BigUInt BigUInt::subMod(const BigUInt& a, const BigUInt& b, const BigUInt& n) {
+    if (n == BigUInt(0)) throw std::runtime_error("Modulo by zero");
+    BigUInt res = a;
+    reduce(res.digits, n);
+    std::vector<uint32_t> rb = b.digits;
+    reduce(rb, n);
+    if (compareWords(res.digits, rb) < 0) addWords(res.digits, n.digits);
+    subWords(res.digits, rb);
+    res.stripZeros();
+    return res;
+}
+
 // v8
 
 BigUInt BigUInt::calculateBarrettMu(const BigUInt& n) {
@@ -269,6 +654,110 @@ BigUInt BigUInt::montgomeryReduction(const BigUInt& T, const BigUInt& n, const B
     return t;
 }
 
+// Bitwise
+
+enum class BitOp { And, Or, Xor };
+
+// a[i] = a[i] op b[i] for i < n.
+static void combineWords(uint32_t* a, const uint32_t* b, size_t n, BitOp op) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        __m256i r = (op == BitOp::And) ? _mm256_and_si256(x, y)
+            : (op == BitOp::Or) ? _mm256_or_si256(x, y)
+            : _mm256_xor_si256(x, y);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), r);
+    }
+#endif
+    for (; i < n; ++i) {
+        if (op == BitOp::And) a[i] &= b[i];
+        else if (op == BitOp::Or) a[i] |= b[i];
+        else a[i] ^= b[i];
+    }
+}
+
+BigUInt& BigUInt::operator&=(const BigUInt& other) {
+    if (digits.size() > other.digits.size()) digits.resize(other.digits.size());
+    combineWords(digits.data(), other.digits.data(), digits.size(), BitOp::And);
+    stripZeros();
+    return *this;
+}
+
+BigUInt& BigUInt::operator|=(const BigUInt& other) {
+    size_t common = std::min(digits.size(), other.digits.size());
+    if (digits.size() < other.digits.size()) digits.insert(digits.end(), other.digits.begin() + common, other.digits.end());
+    combineWords(digits.data(), other.digits.data(), common, BitOp::Or);
+    return *this;
+}
+
+BigUInt& BigUInt::operator^=(const BigUInt& other) {
+    size_t common = std::min(digits.size(), other.digits.size());
+    if (digits.size() < other.digits.size()) digits.insert(digits.end(), other.digits.begin() + common, other.digits.end());
+    combineWords(digits.data(), other.digits.data(), common, BitOp::Xor);
+    stripZeros();
+    return *this;
+}
+
+BigUInt& BigUInt::operator<<=(int bits) { shiftLeft(bits); return *this; }
+BigUInt& BigUInt::operator>>=(int bits) { shiftRight(bits); return *this; }
+
+BigUInt BigUInt::operator&(const BigUInt& other) const { BigUInt res = *this; res &= other; return res; }
+BigUInt BigUInt::operator|(const BigUInt& other) const { BigUInt res = *this; res |= other; return res; }
+BigUInt BigUInt::operator^(const BigUInt& other) const { BigUInt res = *this; res ^= other; return res; }
+BigUInt BigUInt::operator<<(int bits) const { BigUInt res = *this; res.shiftLeft(bits); return res; }
+BigUInt BigUInt::operator>>(int bits) const { BigUInt res = *this; res.shiftRight(bits); return res; }
+
+BigUInt BigUInt::operator~() const {
+    BigUInt res = *this;
+    for (uint32_t& d : res.digits) d = ~d;
+    res.stripZeros();
+    return res;
+}
+
+// Binary I/O
+
+BigUInt BigUInt::fromBytes(std::span<const uint8_t> bytes, ByteOrder order) {
+    BigUInt res;
+    if (bytes.empty()) return res;
+    res.digits.assign((bytes.size() + 3) / 4, 0);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        size_t pos = (order == ByteOrder::LittleEndian) ? i : bytes.size() - 1 - i;
+        res.digits[pos / 4] |= static_cast<uint32_t>(bytes[i]) << (8 * (pos % 4));
+    }
+    res.stripZeros();
+    return res;
+}
+
+BigUInt BigUInt::fromWords(std::span<const uint32_t> words) {
+    BigUInt res;
+    if (words.empty()) return res;
+    res.digits.assign(words.begin(), words.end());
+    res.stripZeros();
+    return res;
+}
+
+size_t BigUInt::byteLength() const {
+    return (static_cast<size_t>(bitLength()) + 7) / 8;
+}
+
+void BigUInt::writeBytes(std::span<uint8_t> out, ByteOrder order) const {
+    if (byteLength() > out.size()) throw std::runtime_error("BigUInt does not fit into the output buffer");
+    for (size_t pos = 0; pos < out.size(); ++pos) {
+        size_t word = pos / 4;
+        uint8_t b = (word < digits.size()) ? static_cast<uint8_t>(digits[word] >> (8 * (pos % 4))) : 0;
+        if (order == ByteOrder::LittleEndian) out[pos] = b;
+        else out[out.size() - 1 - pos] = b;
+    }
+}
+
+std::vector<uint8_t> BigUInt::toBytes(ByteOrder order, size_t width) const {
+    std::vector<uint8_t> out(width == 0 ? std::max<size_t>(byteLength(), 1) : width);
+    writeBytes(out, order);
+    return out;
+}
+
 // pluss
 
 int BigUInt::compare(const BigUInt& other) const {
@@ -318,10 +807,20 @@ std::string BigUInt::toDec() const {
 int BigUInt::bitLength() const {
     if (digits.empty()) return 0;
     int words = static_cast<int>(digits.size()) - 1;
-    uint32_t msb = digits.back();
-    int bits = 0;
-    while (msb > 0) { msb >>= 1; bits++; }
-    return words * 32 + bits;
+    return words * 32 + (32 - std::countl_zero(digits.back()));
+}
+
+int BigUInt::countTrailingZeros() const {
+    for (size_t i = 0; i < digits.size(); ++i) {
+        if (digits[i] != 0) return static_cast<int>(i) * 32 + std::countr_zero(digits[i]);
+    }
+    return 0;
+}
+
+int BigUInt::popcount() const {
+    int count = 0;
+    for (uint32_t d : digits) count += std::popcount(d);
+    return count;
 }
 
 bool BigUInt::getBit(int index) const {
@@ -338,34 +837,68 @@ void BigUInt::setBit(int index) {
     digits[wordIdx] |= (1U << bitIdx);
 }
 
+// Both shifts work in place: shiftLeft walks down from the top word and
+// shiftRight up from the bottom, so every source word is read before it is
+// overwritten. The AVX2 paths handle eight words per step.
 void BigUInt::shiftLeft(int bits) {
-    if (bits == 0) return;
-    int wordShift = bits / 32;
+    if (bits <= 0 || (digits.size() == 1 && digits[0] == 0)) return;
+    size_t wordShift = bits / 32;
     int bitShift = bits % 32;
-    std::vector<uint32_t> newDigits(digits.size() + wordShift + 1, 0);
-    uint64_t carry = 0;
-    for (size_t i = 0; i < digits.size(); ++i) {
-        uint64_t val = (static_cast<uint64_t>(digits[i]) << bitShift) | carry;
-        newDigits[i + wordShift] = static_cast<uint32_t>(val);
-        carry = val >> 32;
+    size_t old = digits.size();
+    digits.resize(old + wordShift + 1, 0);
+    uint32_t* d = digits.data();
+
+    if (bitShift == 0) {
+        std::copy_backward(d, d + old, d + old + wordShift);
+    }
+    else {
+        size_t i = old;
+#if defined(__AVX2__)
+        __m128i left = _mm_cvtsi32_si128(bitShift);
+        __m128i right = _mm_cvtsi32_si128(32 - bitShift);
+        for (; i >= 8; i -= 8) {
+            size_t base = i - 7;
+            __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + base));
+            __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + base - 1));
+            __m256i res = _mm256_or_si256(_mm256_sll_epi32(hi, left), _mm256_srl_epi32(lo, right));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + base + wordShift), res);
+        }
+#endif
+        for (; i > 0; --i) d[i + wordShift] = (d[i] << bitShift) | (d[i - 1] >> (32 - bitShift));
+        d[wordShift] = d[0] << bitShift;
     }
-    if (carry) newDigits[digits.size() + wordShift] = static_cast<uint32_t>(carry);
-    digits = newDigits;
+    std::fill(d, d + wordShift, 0);
     stripZeros();
 }
 
 void BigUInt::shiftRight(int bits) {
-    int wordShift = bits / 32;
+    if (bits <= 0) return;
+    size_t wordShift = bits / 32;
     int bitShift = bits % 32;
-    if (wordShift >= static_cast<int>(digits.size())) { digits = { 0 }; return; }
-    std::vector<uint32_t> newDigits;
-    for (size_t i = wordShift; i < digits.size(); ++i) {
-        uint32_t low = digits[i] >> bitShift;
-        uint32_t high = 0;
-        if (i + 1 < digits.size()) high = digits[i + 1] << (32 - bitShift);
-        newDigits.push_back(low | high);
-    }
-    digits = newDigits;
+    if (wordShift >= digits.size()) { digits.assign(1, 0); return; }
+    size_t size = digits.size();
+    size_t n = size - wordShift;
+    uint32_t* d = digits.data();
+
+    if (bitShift == 0) {
+        std::copy(d + wordShift, d + size, d);
+    }
+    else {
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m128i right = _mm_cvtsi32_si128(bitShift);
+        __m128i left = _mm_cvtsi32_si128(32 - bitShift);
+        for (; i + wordShift + 8 < size; i += 8) {
+            __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + wordShift));
+            __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i + wordShift + 1));
+            __m256i res = _mm256_or_si256(_mm256_srl_epi32(lo, right), _mm256_sll_epi32(hi, left));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), res);
+        }
+#endif
+        for (; i + 1 < n; ++i) d[i] = (d[i + wordShift] >> bitShift) | (d[i + wordShift + 1] << (32 - bitShift));
+        d[n - 1] = d[size - 1] >> bitShift;
+    }
+    digits.resize(n);
     stripZeros();
 }
 
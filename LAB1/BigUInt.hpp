@@ -5,12 +5,16 @@
 #include <iostream>
 #include <cstdint>
 #include <algorithm>
+#include <span>
 
 class BigUInt {
 public:
     BigUInt();
     BigUInt(uint64_t n);
     explicit BigUInt(const std::string& str);
+    // True for a non-empty run of decimal digits or "0x" followed by at least
+    // one hex digit; the string constructor assumes input of this shape.
+    static bool isNumber(const std::string& str);
 
     // Lab1
     BigUInt operator+(const BigUInt& other) const;
@@ -36,6 +40,19 @@ public:
     static BigUInt lcm(const BigUInt& a, const BigUInt& b);
     BigUInt powMod(const BigUInt& exponent, const BigUInt& modulus) const;
 
+    // Products. product() multiplies along a balanced tree whose larger
+    // levels run in parallel; factorial uses prime swing.
+    static BigUInt product(std::span<const BigUInt> values);
+    static BigUInt factorial(uint32_t n);
+    static BigUInt binomial(uint32_t n, uint32_t k);
+
+    // Modular primitives
+    static BigUInt addMod(const BigUInt& a, const BigUInt& b, const BigUInt& n);
+    static BigUInt subMod(const BigUInt& a, const BigUInt& b, const BigUInt& n);
+    static BigUInt mulMod(const BigUInt& a, const BigUInt& b, const BigUInt& n);
+    static BigUInt sqrMod(const BigUInt& a, const BigUInt& n);
+    static BigUInt mulAdd(const BigUInt& a, const BigUInt& b, const BigUInt& c);
+
     // v8
     static BigUInt calculateBarrettMu(const BigUInt& n);
     static BigUInt barrettReduction(const BigUInt& x, const BigUInt& n, const BigUInt& mu);
@@ -44,11 +61,36 @@ public:
     static BigUInt calculateMontgomeryInverse(const BigUInt& n, const BigUInt& R);
     static BigUInt montgomeryReduction(const BigUInt& T, const BigUInt& n, const BigUInt& n_prime, const BigUInt& R);
 
+    // Bitwise. operator~ flips every bit of the stored words, so its width is
+    // the operand's word count rounded up to 32 bits.
+    BigUInt operator&(const BigUInt& other) const;
+    BigUInt operator|(const BigUInt& other) const;
+    BigUInt operator^(const BigUInt& other) const;
+    BigUInt operator~() const;
+    BigUInt operator<<(int bits) const;
+    BigUInt operator>>(int bits) const;
+    BigUInt& operator&=(const BigUInt& other);
+    BigUInt& operator|=(const BigUInt& other);
+    BigUInt& operator^=(const BigUInt& other);
+    BigUInt& operator<<=(int bits);
+    BigUInt& operator>>=(int bits);
+
+    // Binary I/O
+    enum class ByteOrder { BigEndian, LittleEndian };
+    static BigUInt fromBytes(std::span<const uint8_t> bytes, ByteOrder order = ByteOrder::BigEndian);
+    static BigUInt fromWords(std::span<const uint32_t> words);
+    std::vector<uint8_t> toBytes(ByteOrder order = ByteOrder::BigEndian, size_t width = 0) const;
+    void writeBytes(std::span<uint8_t> out, ByteOrder order = ByteOrder::BigEndian) const;
+    size_t byteLength() const;
+    std::span<const uint32_t> words() const { return digits; }
+
     struct GcdResult;
     static GcdResult extendedGcd(const BigUInt& a, const BigUInt& b);
 
 
     int bitLength() const;
+    int countTrailingZeros() const;     // 0 for zero
+    int popcount() const;
     bool getBit(int index) const;
     void setBit(int index);
     void shiftLeft(int bits);
@@ -60,6 +102,14 @@ private:
 
     void stripZeros();
     static void divMod(const BigUInt& dividend, const BigUInt& divisor, BigUInt& quotient, BigUInt& remainder);
+    static void divModKnuth(const std::vector<uint32_t>& u, const std::vector<uint32_t>& v,
+        std::vector<uint32_t>* q, std::vector<uint32_t>& r);
+    static void reduce(std::vector<uint32_t>& x, const BigUInt& n);
+    static void divModRecursive(const BigUInt& a, const BigUInt& b, BigUInt& quotient, BigUInt& remainder);
+    static void divTwoByOne(const BigUInt& a, const BigUInt& b, size_t n, BigUInt& q, BigUInt& r);
+    static void divThreeByTwo(const BigUInt& a, const BigUInt& b, size_t half, BigUInt& q, BigUInt& r);
+    BigUInt wordSlice(size_t from, size_t count) const;
+    void shiftLeftWords(size_t words);
 };
 
 std::ostream& operator<<(std::ostream& os, const BigUInt& num);
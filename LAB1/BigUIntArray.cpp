@@ -0,0 +1,153 @@
+#include "BigUIntArray.hpp"
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Limbs and index entries are stored in host order, which must be little-endian.
+static_assert(std::endian::native == std::endian::little, "BigUIntArray requires a little-endian host");
+
+namespace {
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t count;
+        uint64_t indexOffset;
+    };
+    static_assert(sizeof(Header) == BigUIntArray::HEADER_SIZE);
+}
+
+void BigUIntArray::write(const std::string& path, std::span<const BigUInt> values) {
+    BigUIntArrayWriter writer(path);
+    for (const BigUInt& v : values) writer.append(v);
+    writer.close();
+}
+
+// BigUIntArrayWriter
+
+BigUIntArrayWriter::BigUIntArrayWriter(const std::string& path) : out(path, std::ios::binary | std::ios::trunc) {
+    if (!out) throw std::runtime_error("Cannot open " + path + " for writing");
+    Header h{};
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    offsets.push_back(0);
+}
+
+BigUIntArrayWriter::~BigUIntArrayWriter() {
+    try { close(); }
+    catch (...) {}
+}
+
+void BigUIntArrayWriter::append(const BigUInt& value) {
+    if (!out.is_open()) throw std::runtime_error("BigUIntArrayWriter is closed");
+    std::span<const uint32_t> w = value.words();
+    out.write(reinterpret_cast<const char*>(w.data()), static_cast<std::streamsize>(w.size_bytes()));
+    offsets.push_back(offsets.back() + w.size());
+}
+
+void BigUIntArrayWriter::close() {
+    if (!out.is_open()) return;
+
+    uint64_t indexOffset = BigUIntArray::HEADER_SIZE + offsets.back() * sizeof(uint32_t);
+    if (indexOffset % sizeof(uint64_t) != 0) {
+        uint32_t pad = 0;
+        out.write(reinterpret_cast<const char*>(&pad), sizeof(pad));
+        indexOffset += sizeof(pad);
+    }
+    out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+
+    Header h{};
+    std::memcpy(h.magic, BigUIntArray::MAGIC, sizeof(h.magic));
+    h.version = BigUIntArray::VERSION;
+    h.count = offsets.size() - 1;
+    h.indexOffset = indexOffset;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    bool ok = static_cast<bool>(out);
+    out.close();
+    if (!ok) throw std::runtime_error("Failed to write BigUIntArray file");
+}
+
+// MappedBigUIntArray
+
+MappedBigUIntArray::MappedBigUIntArray(const std::string& path) {
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) throw std::runtime_error("Cannot open " + path);
+    file = f;
+    LARGE_INTEGER sz;
+    if (!GetFileSizeEx(f, &sz)) { CloseHandle(f); throw std::runtime_error("Cannot stat " + path); }
+    length = static_cast<size_t>(sz.QuadPart);
+    if (length > 0) {
+        HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m) { CloseHandle(f); throw std::runtime_error("Cannot map " + path); }
+        mapping = m;
+        base = static_cast<const uint8_t*>(MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0));
+        if (!base) { CloseHandle(m); CloseHandle(f); throw std::runtime_error("Cannot map " + path); }
+    }
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0) { ::close(fd); throw std::runtime_error("Cannot stat " + path); }
+    length = static_cast<size_t>(st.st_size);
+    if (length > 0) {
+        void* p = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) { ::close(fd); throw std::runtime_error("Cannot map " + path); }
+        base = static_cast<const uint8_t*>(p);
+    }
+#endif
+
+    Header h{};
+    if (length < sizeof(h)) { release(); throw std::runtime_error("Not a BigUIntArray file: " + path); }
+    std::memcpy(&h, base, sizeof(h));
+    bool valid = std::memcmp(h.magic, BigUIntArray::MAGIC, sizeof(h.magic)) == 0
+        && h.version == BigUIntArray::VERSION
+        && h.indexOffset % sizeof(uint64_t) == 0
+        && h.indexOffset >= sizeof(h)
+        && h.indexOffset <= length
+        && h.count < (length - h.indexOffset) / sizeof(uint64_t);
+    if (valid) {
+        count = static_cast<size_t>(h.count);
+        data = reinterpret_cast<const uint32_t*>(base + sizeof(h));
+        index = reinterpret_cast<const uint64_t*>(base + h.indexOffset);
+        valid = index[count] <= (h.indexOffset - sizeof(h)) / sizeof(uint32_t);
+    }
+    if (!valid) { release(); throw std::runtime_error("Corrupt BigUIntArray file: " + path); }
+}
+
+MappedBigUIntArray::~MappedBigUIntArray() {
+    release();
+}
+
+void MappedBigUIntArray::release() {
+#ifdef _WIN32
+    if (base) UnmapViewOfFile(base);
+    if (mapping) CloseHandle(static_cast<HANDLE>(mapping));
+    if (file) CloseHandle(static_cast<HANDLE>(file));
+    mapping = file = nullptr;
+#else
+    if (base) ::munmap(const_cast<uint8_t*>(base), length);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    base = nullptr;
+}
+
+std::span<const uint32_t> MappedBigUIntArray::words(size_t i) const {
+    if (i >= count) throw std::out_of_range("MappedBigUIntArray index out of range");
+    uint64_t from = index[i], to = index[i + 1];
+    if (from > to || to > index[count]) throw std::runtime_error("Corrupt BigUIntArray index");
+    return { data + from, static_cast<size_t>(to - from) };
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <vector>
+#include "BigUInt.hpp"
+
+// On-disk array of BigUInt values that can be memory-mapped and read without
+// parsing. All fields are little-endian:
+//
+//   header   magic "BUINTARR", u32 version, u32 reserved, u64 count, u64 indexOffset
+//   data     the 32-bit limbs of every value, least significant limb first
+//   index    u64[count + 1] limb offsets into the data section
+//
+// Value i occupies limbs [index[i], index[i + 1]).
+namespace BigUIntArray {
+    constexpr char MAGIC[8] = { 'B', 'U', 'I', 'N', 'T', 'A', 'R', 'R' };
+    constexpr uint32_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = 32;
+
+    void write(const std::string& path, std::span<const BigUInt> values);
+}
+
+// Appends values one at a time; the index is written by close().
+class BigUIntArrayWriter {
+public:
+    explicit BigUIntArrayWriter(const std::string& path);
+    ~BigUIntArrayWriter();
+
+    BigUIntArrayWriter(const BigUIntArrayWriter&) = delete;
+    BigUIntArrayWriter& operator=(const BigUIntArrayWriter&) = delete;
+
+    void append(const BigUInt& value);
+    void close();
+
+private:
+    std::ofstream out;
+    std::vector<uint64_t> offsets;
+};
+
+// Read-only memory mapping of a BigUIntArray file. Elements are exposed as
+// spans of limbs pointing straight into the mapping.
+class MappedBigUIntArray {
+public:
+    explicit MappedBigUIntArray(const std::string& path);
+    ~MappedBigUIntArray();
+
+    MappedBigUIntArray(const MappedBigUIntArray&) = delete;
+    MappedBigUIntArray& operator=(const MappedBigUIntArray&) = delete;
+
+    size_t size() const { return count; }
+    std::span<const uint32_t> words(size_t i) const;
+    BigUInt at(size_t i) const { return BigUInt::fromWords(words(i)); }
+    std::span<const uint32_t> operator[](size_t i) const { return words(i); }
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::span<const uint32_t>;
+        using difference_type = std::ptrdiff_t;
+
+        const_iterator(const MappedBigUIntArray* arr, size_t i) : arr(arr), i(i) {}
+        value_type operator*() const { return arr->words(i); }
+        const_iterator& operator++() { ++i; return *this; }
+        bool operator==(const const_iterator& o) const { return i == o.i; }
+        bool operator!=(const const_iterator& o) const { return i != o.i; }
+
+    private:
+        const MappedBigUIntArray* arr;
+        size_t i;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+private:
+    void release();
+
+    const uint8_t* base = nullptr;
+    size_t length = 0;
+    size_t count = 0;
+    const uint32_t* data = nullptr;
+    const uint64_t* index = nullptr;
+
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
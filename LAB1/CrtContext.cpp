@@ -0,0 +1,72 @@
+#include "CrtContext.hpp"
+#include <future>
+#include <stdexcept>
+
+static BigUInt modInverse(const BigUInt& a, const BigUInt& m) {
+    BigUInt::GcdResult res = BigUInt::extendedGcd(a % m, m);
+    if (res.gcd != BigUInt(1)) throw std::runtime_error("CRT factors are not coprime");
+    BigUInt x = res.x % m;
+    if (res.x_neg && x != BigUInt(0)) return m - x;
+    return x;
+}
+
+// The (p, q) form stores the factors as {q, p}, so the single Garner
+// coefficient is the usual RSA qInv = q^-1 mod p.
+CrtContext::CrtContext(const BigUInt& p, const BigUInt& q, const BigUInt& exponent)
+    : CrtContext(std::vector<BigUInt>{ q, p }, exponent) {
+}
+
+CrtContext::CrtContext(const std::vector<BigUInt>& primes, const BigUInt& exponent)
+    : factors(primes), n(1) {
+    if (factors.empty()) throw std::runtime_error("CRT needs at least one factor");
+
+    for (size_t i = 0; i < factors.size(); ++i) {
+        if (factors[i] <= BigUInt(1)) throw std::runtime_error("CRT factor must be greater than 1");
+        // A reduced exponent of 0 would map a base divisible by pi to 1
+        // instead of 0, so large exponents keep one extra period.
+        BigUInt period = factors[i] - BigUInt(1);
+        exponents.push_back(exponent >= period ? exponent % period + period : exponent);
+        coefficients.push_back(i == 0 ? BigUInt(0) : modInverse(n, factors[i]));
+        n = n * factors[i];
+    }
+}
+
+BigUInt CrtContext::powMod(const BigUInt& base, bool parallel) const {
+    std::vector<BigUInt> residues(factors.size());
+
+    if (parallel && factors.size() > 1) {
+        std::vector<std::future<BigUInt>> jobs;
+        for (size_t i = 1; i < factors.size(); ++i) {
+            jobs.push_back(std::async(std::launch::async, [this, &base, i]() {
+                return base.powMod(exponents[i], factors[i]);
+                }));
+        }
+        residues[0] = base.powMod(exponents[0], factors[0]);
+        for (size_t i = 1; i < factors.size(); ++i) residues[i] = jobs[i - 1].get();
+    }
+    else {
+        for (size_t i = 0; i < factors.size(); ++i) {
+            residues[i] = base.powMod(exponents[i], factors[i]);
+        }
+    }
+    return combine(residues);
+}
+
+// Garner: x = v1 + v2*p1 + v3*p1*p2 + ..., where
+// vi = (ri - x(i-1)) * coefficients[i] mod pi.
+BigUInt CrtContext::combine(const std::vector<BigUInt>& residues) const {
+    if (residues.size() != factors.size()) throw std::runtime_error("CRT residue count mismatch");
+
+    BigUInt x = residues[0] % factors[0];
+    BigUInt prefix = factors[0];
+    for (size_t i = 1; i < factors.size(); ++i) {
+        const BigUInt& p = factors[i];
+        BigUInt r = residues[i] % p;
+        BigUInt xr = x % p;
+        BigUInt diff = (r >= xr) ? r - xr : (r + p) - xr;
+        BigUInt v = (diff * coefficients[i]) % p;
+        x = x + v * prefix;
+        prefix = prefix * p;
+    }
+    return x;
+}
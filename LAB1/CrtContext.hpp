@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+#include "BigUInt.hpp"
+
+// Exponentiation modulo n = p1 * p2 * ... * pk for distinct primes pi.
+// Each factor gets its own half-size (or k-th size) powMod with the exponent
+// reduced modulo (pi - 1); the residues are recombined with Garner's formula.
+// Fermat's little theorem justifies the reduction only for prime factors.
+class CrtContext {
+public:
+    CrtContext(const BigUInt& p, const BigUInt& q, const BigUInt& exponent);
+    CrtContext(const std::vector<BigUInt>& primes, const BigUInt& exponent);
+
+    BigUInt powMod(const BigUInt& base, bool parallel = false) const;
+    BigUInt combine(const std::vector<BigUInt>& residues) const;
+
+    const BigUInt& modulus() const { return n; }
+    const std::vector<BigUInt>& primes() const { return factors; }
+
+private:
+    std::vector<BigUInt> factors;
+    std::vector<BigUInt> exponents;     // exponent mod (pi - 1), kept >= pi - 1 when it was
+    std::vector<BigUInt> coefficients;  // (p1 * ... * p(i-1))^-1 mod pi, coefficients[0] unused
+    BigUInt n;
+};
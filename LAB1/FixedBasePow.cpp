@@ -0,0 +1,161 @@
+#include "FixedBasePow.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+static const char FBP_MAGIC[4] = { 'F', 'B', 'P', 'W' };
+static const uint32_t FBP_VERSION = 1;
+static const size_t FBP_CHUNK_WORDS = size_t(1) << 16;
+
+static void writeU32(std::ostream& out, uint32_t x) {
+    uint8_t buf[4] = { static_cast<uint8_t>(x), static_cast<uint8_t>(x >> 8),
+        static_cast<uint8_t>(x >> 16), static_cast<uint8_t>(x >> 24) };
+    out.write(reinterpret_cast<const char*>(buf), 4);
+}
+
+static uint32_t readU32(std::istream& in) {
+    uint8_t buf[4];
+    if (!in.read(reinterpret_cast<char*>(buf), 4)) throw std::runtime_error("Truncated FixedBasePow table");
+    return buf[0] | (buf[1] << 8) | (buf[2] << 16) | (static_cast<uint32_t>(buf[3]) << 24);
+}
+
+static void writeNumber(std::ostream& out, const BigUInt& x) {
+    std::span<const uint32_t> w = x.words();
+    writeU32(out, static_cast<uint32_t>(w.size()));
+    for (uint32_t d : w) writeU32(out, d);
+}
+
+static BigUInt readNumber(std::istream& in) {
+    uint32_t size = readU32(in);
+    if (size == 0 || size > (1u << 20)) throw std::runtime_error("Corrupt FixedBasePow table");
+    std::vector<uint32_t> w(size);
+    for (uint32_t& d : w) d = readU32(in);
+    return BigUInt::fromWords(w);
+}
+
+void FixedBasePow::layout(int maxExpBits, int teeth, int subTables) {
+    if (maxExpBits < 1) throw std::runtime_error("FixedBasePow needs a positive exponent size");
+    if (teeth < 1 || teeth > 16) throw std::runtime_error("FixedBasePow teeth must be in [1, 16]");
+    if (subTables < 1) throw std::runtime_error("FixedBasePow needs at least one sub-table");
+    maxBits = maxExpBits;
+    h = teeth;
+    a = (maxExpBits - 1) / h + 1;
+    b = (a - 1) / subTables + 1;
+    v = (a - 1) / b + 1;
+}
+
+FixedBasePow::FixedBasePow(const BigUInt& g, const BigUInt& n, int maxExpBits, int teeth, int subTables)
+    : ctx(MontgomeryContext::create(n)), g(g % n) {
+    layout(maxExpBits, teeth, subTables);
+
+    size_t k = ctx->size();
+    size_t rows = size_t(1) << h;
+
+    // powers[j] = g^(2^j) for every bit position a row/column can start at.
+    std::vector<std::vector<uint32_t>> powers(static_cast<size_t>(h) * a);
+    powers[0] = ctx->toMontgomery(this->g);
+    for (size_t j = 1; j < powers.size(); ++j) {
+        powers[j].resize(k);
+        ctx->mul(powers[j - 1].data(), powers[j - 1].data(), powers[j].data());
+    }
+
+    // table[s][u] = prod over set bits i of u of g^(2^(i*a + s*b)).
+    table.assign(static_cast<size_t>(v) * rows * k, 0);
+    for (int s = 0; s < v; ++s) {
+        uint32_t* sub = table.data() + static_cast<size_t>(s) * rows * k;
+        std::copy(ctx->one().begin(), ctx->one().end(), sub);
+        for (size_t u = 1; u < rows; ++u) {
+            int top = std::bit_width(u) - 1;
+            size_t rest = u ^ (size_t(1) << top);
+            const std::vector<uint32_t>& p = powers[static_cast<size_t>(top) * a + static_cast<size_t>(s) * b];
+            ctx->mul(sub + rest * k, p.data(), sub + u * k);
+        }
+    }
+}
+
+BigUInt FixedBasePow::pow(const BigUInt& exponent) const {
+    if (exponent.bitLength() > maxBits) return ModInt(ctx, g).pow(exponent).toBigUInt();
+
+    size_t k = ctx->size();
+    size_t rows = size_t(1) << h;
+    std::vector<uint32_t> res = ctx->one();
+    bool started = false;
+
+    for (int t = b - 1; t >= 0; --t) {
+        if (started) ctx->mul(res.data(), res.data(), res.data());
+        for (int s = v - 1; s >= 0; --s) {
+            int col = s * b + t;
+            if (col >= a) continue;
+            size_t u = 0;
+            for (int i = h - 1; i >= 0; --i) u = (u << 1) | (exponent.getBit(i * a + col) ? 1 : 0);
+            if (u == 0) continue;
+            const uint32_t* entry = table.data() + (static_cast<size_t>(s) * rows + u) * k;
+            if (started) ctx->mul(res.data(), entry, res.data());
+            else std::copy(entry, entry + k, res.begin());
+            started = true;
+        }
+    }
+    return ctx->fromMontgomery(res);
+}
+
+size_t FixedBasePow::tableBytes() const {
+    return table.size() * sizeof(uint32_t);
+}
+
+// Layout: magic, version, maxBits, teeth, subTables, g, n, then the table
+// words. All integers are little-endian 32-bit.
+void FixedBasePow::save(std::ostream& out) const {
+    out.write(FBP_MAGIC, sizeof(FBP_MAGIC));
+    writeU32(out, FBP_VERSION);
+    writeU32(out, static_cast<uint32_t>(maxBits));
+    writeU32(out, static_cast<uint32_t>(h));
+    writeU32(out, static_cast<uint32_t>(v));
+    writeNumber(out, g);
+    writeNumber(out, ctx->modulus());
+    for (uint32_t w : table) writeU32(out, w);
+    if (!out) throw std::runtime_error("Failed to write FixedBasePow table");
+}
+
+FixedBasePow FixedBasePow::load(std::istream& in) {
+    char magic[sizeof(FBP_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), FBP_MAGIC)) {
+        throw std::runtime_error("Not a FixedBasePow table");
+    }
+    if (readU32(in) != FBP_VERSION) throw std::runtime_error("Unsupported FixedBasePow table version");
+
+    FixedBasePow res;
+    int maxExpBits = static_cast<int>(readU32(in));
+    int teeth = static_cast<int>(readU32(in));
+    int subTables = static_cast<int>(readU32(in));
+    res.layout(maxExpBits, teeth, subTables);
+    if (res.v != subTables) throw std::runtime_error("Corrupt FixedBasePow table");
+
+    res.g = readNumber(in);
+    res.ctx = MontgomeryContext::create(readNumber(in));
+    if (res.g >= res.ctx->modulus()) throw std::runtime_error("Corrupt FixedBasePow table");
+
+    // The header is untrusted: check the table size against the bytes left
+    // when the stream can tell, and grow the table only as words arrive, so
+    // a forged header cannot allocate more than the input actually holds.
+    size_t rowWords = (size_t(1) << res.h) * res.ctx->size();
+    if (static_cast<size_t>(res.v) > SIZE_MAX / sizeof(uint32_t) / rowWords) throw std::runtime_error("Corrupt FixedBasePow table");
+    size_t words = static_cast<size_t>(res.v) * rowWords;
+
+    std::streampos pos = in.tellg();
+    if (pos != std::streampos(-1)) {
+        in.seekg(0, std::ios::end);
+        std::streamoff remaining = in.tellg() - pos;
+        in.seekg(pos);
+        if (!in || remaining < 0 || static_cast<uint64_t>(remaining) / sizeof(uint32_t) < words) {
+            throw std::runtime_error("Truncated FixedBasePow table");
+        }
+    }
+
+    while (res.table.size() < words) {
+        size_t start = res.table.size();
+        res.table.resize(start + std::min(words - start, FBP_CHUNK_WORDS));
+        for (size_t i = start; i < res.table.size(); ++i) res.table[i] = readU32(in);
+    }
+    return res;
+}
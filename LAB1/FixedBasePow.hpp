@@ -0,0 +1,46 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "BigUInt.hpp"
+#include "ModInt.hpp"
+
+// g^e mod n for a fixed g and odd n using a Lim-Lee comb.
+//
+// The exponent, padded to teeth * a bits (a = ceil(maxExpBits / teeth)), is
+// read as `teeth` rows of a bits; each row is split into `subTables` columns
+// of b = ceil(a / subTables) bits. The table holds subTables * 2^teeth
+// precomputed products, and one call costs b - 1 squarings and at most a
+// multiplications. More teeth or sub-tables trade memory for speed.
+//
+// The object is immutable after construction, so a single instance can be
+// shared by any number of threads.
+class FixedBasePow {
+public:
+    FixedBasePow(const BigUInt& g, const BigUInt& n, int maxExpBits, int teeth = 6, int subTables = 2);
+
+    // Exponents longer than maxExpBits fall back to a plain ModInt::pow.
+    BigUInt pow(const BigUInt& exponent) const;
+
+    const BigUInt& base() const { return g; }
+    const BigUInt& modulus() const { return ctx->modulus(); }
+    int maxExponentBits() const { return maxBits; }
+    size_t tableBytes() const;
+
+    void save(std::ostream& out) const;
+    static FixedBasePow load(std::istream& in);
+
+private:
+    FixedBasePow() = default;
+    void layout(int maxExpBits, int teeth, int subTables);
+
+    std::shared_ptr<const MontgomeryContext> ctx;
+    BigUInt g;
+    int maxBits = 0;
+    int h = 0;      // teeth
+    int v = 0;      // sub-tables
+    int a = 0;      // row length
+    int b = 0;      // column length
+    std::vector<uint32_t> table;    // v * 2^h entries of ctx->size() words, Montgomery form
+};
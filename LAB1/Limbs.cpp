@@ -0,0 +1,149 @@
+#include "Limbs.hpp"
+#include <algorithm>
+#include <future>
+#include "Parallel.hpp"
+
+// Karatsuba steps on halves of at least this many words run their three
+// sub-products on spare threads, so a single huge product (the top of a
+// product tree, or the quotient estimates of a huge division) uses the cores.
+static const size_t PARALLEL_KARATSUBA_WORDS = 4096;
+
+// out[0, na + nb) = a * b, out must be zeroed.
+static void mulSchoolbook(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    for (size_t i = 0; i < na; ++i) {
+        uint64_t carry = 0;
+        uint64_t ai = a[i];
+        if (ai == 0) continue;
+        for (size_t j = 0; j < nb; ++j) {
+            uint64_t cur = out[i + j] + ai * b[j] + carry;
+            out[i + j] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+        out[i + nb] = static_cast<uint32_t>(carry);
+    }
+}
+
+uint32_t addLimbs(uint32_t* out, size_t outLen, const uint32_t* x, size_t nx) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < nx && i < outLen; ++i) {
+        uint64_t sum = static_cast<uint64_t>(out[i]) + x[i] + carry;
+        out[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    for (; carry && i < outLen; ++i) {
+        uint64_t sum = static_cast<uint64_t>(out[i]) + carry;
+        out[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    return static_cast<uint32_t>(carry);
+}
+
+uint32_t subLimbs(uint32_t* x, size_t nx, const uint32_t* y, size_t ny) {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < nx && (i < ny || borrow); ++i) {
+        int64_t diff = static_cast<int64_t>(x[i]) - (i < ny ? y[i] : 0) - borrow;
+        borrow = diff < 0;
+        x[i] = static_cast<uint32_t>(diff);
+    }
+    return static_cast<uint32_t>(borrow);
+}
+
+// out[0, na + nb) = a * b, out must be zeroed. Splits the longer operand
+// into slices when the sizes are far apart, so each Karatsuba step works on
+// roughly balanced halves.
+static void mulKaratsuba(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    if (na < nb) { std::swap(a, b); std::swap(na, nb); }
+    if (nb < KARATSUBA_THRESHOLD) {
+        mulSchoolbook(a, na, b, nb, out);
+        return;
+    }
+    if (na >= 2 * nb) {
+        std::vector<uint32_t> tmp(2 * nb);
+        for (size_t off = 0; off < na; off += nb) {
+            size_t len = std::min(nb, na - off);
+            std::fill(tmp.begin(), tmp.end(), 0);
+            mulKaratsuba(a + off, len, b, nb, tmp.data());
+            addLimbs(out + off, na + nb - off, tmp.data(), len + nb);
+        }
+        return;
+    }
+
+    size_t m = na / 2;
+    size_t n1a = na - m, n1b = nb - m;
+
+    std::vector<uint32_t> sa(n1a + 1, 0), sb(std::max(m, n1b) + 1, 0);
+    std::copy(a + m, a + na, sa.begin());
+    addLimbs(sa.data(), sa.size(), a, m);
+    std::copy(b, b + m, sb.begin());
+    addLimbs(sb.data(), sb.size(), b + m, n1b);
+    std::vector<uint32_t> z1(sa.size() + sb.size(), 0);
+
+    // z0, z2 and z1 write to disjoint buffers, so they can run concurrently.
+    auto z0 = [&]() { mulKaratsuba(a, m, b, m, out); };
+    auto z2 = [&]() { mulKaratsuba(a + m, n1a, b + m, n1b, out + 2 * m); };
+    auto mid = [&]() { mulKaratsuba(sa.data(), sa.size(), sb.data(), sb.size(), z1.data()); };
+    bool forked = false;
+    if (m >= PARALLEL_KARATSUBA_WORDS) {
+        SpareThread first, second;
+        if (first) {
+            // The futures are declared after the guards, so they join (also
+            // on an exception in z0) before the threads go back to the budget.
+            std::future<void> high = std::async(std::launch::async, z2);
+            std::future<void> middle;
+            if (second) middle = std::async(std::launch::async, mid);
+            z0();
+            if (!second) mid();
+            high.get();
+            if (second) middle.get();
+            forked = true;
+        }
+    }
+    if (!forked) {
+        z0();
+        z2();
+        mid();
+    }
+    subLimbs(z1.data(), z1.size(), out, 2 * m);
+    subLimbs(z1.data(), z1.size(), out + 2 * m, n1a + n1b);
+    addLimbs(out + m, na + nb - m, z1.data(), z1.size());
+}
+
+// out = a * a with each cross product computed once: the doubled sum of
+// a[i] * a[j] for i < j, plus the diagonal squares.
+static void sqrSchoolbook(const uint32_t* a, size_t n, uint32_t* out) {
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t carry = 0;
+        uint64_t ai = a[i];
+        for (size_t j = i + 1; j < n; ++j) {
+            uint64_t cur = out[i + j] + ai * a[j] + carry;
+            out[i + j] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+        out[i + n] = static_cast<uint32_t>(carry);
+    }
+    uint32_t top = 0;
+    for (size_t k = 0; k < 2 * n; ++k) {
+        uint32_t w = out[k];
+        out[k] = (w << 1) | top;
+        top = w >> 31;
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t sq = static_cast<uint64_t>(a[i]) * a[i];
+        uint64_t lo = static_cast<uint64_t>(out[2 * i]) + static_cast<uint32_t>(sq) + carry;
+        out[2 * i] = static_cast<uint32_t>(lo);
+        uint64_t hi = static_cast<uint64_t>(out[2 * i + 1]) + (sq >> 32) + (lo >> 32);
+        out[2 * i + 1] = static_cast<uint32_t>(hi);
+        carry = hi >> 32;
+    }
+}
+
+void mulLimbs(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out) {
+    mulKaratsuba(a, na, b, nb, out);
+}
+
+void sqrLimbs(const uint32_t* a, size_t n, uint32_t* out) {
+    if (n < KARATSUBA_THRESHOLD) sqrSchoolbook(a, n, out);
+    else mulKaratsuba(a, n, a, n, out);
+}
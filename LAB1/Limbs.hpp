@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Word-level kernels shared by BigUInt and the reduction contexts. Numbers
+// are little-endian arrays of 32-bit limbs in caller-owned buffers.
+
+// Operands of at least this many words on both sides use Karatsuba.
+inline constexpr size_t KARATSUBA_THRESHOLD = 48;
+
+// out[0, na + nb) = a * b, out must be zeroed. Schoolbook below
+// KARATSUBA_THRESHOLD, Karatsuba above it.
+void mulLimbs(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, uint32_t* out);
+// out[0, 2n) = a * a, out must be zeroed.
+void sqrLimbs(const uint32_t* a, size_t n, uint32_t* out);
+// out[0, outLen) += x[0, nx); returns the carry out of the top word.
+uint32_t addLimbs(uint32_t* out, size_t outLen, const uint32_t* x, size_t nx);
+// x[0, nx) -= y[0, ny); returns the borrow, which is 0 when x >= y.
+uint32_t subLimbs(uint32_t* x, size_t nx, const uint32_t* y, size_t ny);
+
+// out = a * b and out = a * a, sized to the full product.
+inline void mulLimbs(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b, std::vector<uint32_t>& out) {
+    out.assign(a.size() + b.size(), 0);
+    mulLimbs(a.data(), a.size(), b.data(), b.size(), out.data());
+}
+
+inline void sqrLimbs(const std::vector<uint32_t>& a, std::vector<uint32_t>& out) {
+    out.assign(2 * a.size(), 0);
+    sqrLimbs(a.data(), a.size(), out.data());
+}
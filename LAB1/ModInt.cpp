@@ -0,0 +1,227 @@
+#include "ModInt.hpp"
+#include <iterator>
+#include <stdexcept>
+
+// MontgomeryContext
+
+MontgomeryContext::MontgomeryContext(const BigUInt& n) : n(n) {
+    if (!n.getBit(0)) throw std::runtime_error("Montgomery form requires an odd modulus");
+    if (n == BigUInt(1)) throw std::runtime_error("Montgomery modulus must be greater than 1");
+
+    std::span<const uint32_t> w = n.words();
+    nWords.assign(w.begin(), w.end());
+    k = nWords.size();
+
+    // Newton iteration: each step doubles the number of correct low bits.
+    uint32_t inv = 1;
+    for (int i = 0; i < 5; ++i) inv *= 2 - nWords[0] * inv;
+    nInv = 0 - inv;
+
+    BigUInt r = (BigUInt(1) << static_cast<int>(32 * k)) % n;
+    std::span<const uint32_t> rw = r.words();
+    rModN.assign(k, 0);
+    std::copy(rw.begin(), rw.end(), rModN.begin());
+
+    BigUInt r2 = (r * r) % n;
+    std::span<const uint32_t> r2w = r2.words();
+    r2ModN.assign(k, 0);
+    std::copy(r2w.begin(), r2w.end(), r2ModN.begin());
+}
+
+std::shared_ptr<const MontgomeryContext> MontgomeryContext::create(const BigUInt& n) {
+    return std::make_shared<const MontgomeryContext>(n);
+}
+
+// Coarsely integrated operand scanning (CIOS): interleaves one word of the
+// product with one word of the reduction, keeping the accumulator at k + 2 words.
+void MontgomeryContext::mul(const uint32_t* a, const uint32_t* b, uint32_t* out) const {
+    // Moduli up to 4096 bits keep the accumulator on the stack.
+    uint32_t small[130];
+    std::vector<uint32_t> large;
+    uint32_t* t = small;
+    if (k + 2 > std::size(small)) {
+        large.assign(k + 2, 0);
+        t = large.data();
+    }
+    else {
+        std::fill(t, t + k + 2, 0);
+    }
+    const uint32_t* nw = nWords.data();
+
+    for (size_t i = 0; i < k; ++i) {
+        uint64_t carry = 0;
+        uint64_t bi = b[i];
+        for (size_t j = 0; j < k; ++j) {
+            uint64_t cur = t[j] + a[j] * bi + carry;
+            t[j] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+        uint64_t cur = t[k] + carry;
+        t[k] = static_cast<uint32_t>(cur);
+        t[k + 1] = static_cast<uint32_t>(cur >> 32);
+
+        uint64_t m = static_cast<uint32_t>(t[0] * nInv);
+        carry = (t[0] + m * nw[0]) >> 32;
+        for (size_t j = 1; j < k; ++j) {
+            cur = t[j] + m * nw[j] + carry;
+            t[j - 1] = static_cast<uint32_t>(cur);
+            carry = cur >> 32;
+        }
+        cur = t[k] + carry;
+        t[k - 1] = static_cast<uint32_t>(cur);
+        t[k] = t[k + 1] + static_cast<uint32_t>(cur >> 32);
+    }
+
+    bool geq = t[k] != 0;
+    if (!geq) {
+        geq = true;
+        for (size_t i = k; i-- > 0;) {
+            if (t[i] != nw[i]) { geq = t[i] > nw[i]; break; }
+        }
+    }
+    if (geq) {
+        int64_t borrow = 0;
+        for (size_t i = 0; i < k; ++i) {
+            int64_t diff = static_cast<int64_t>(t[i]) - nw[i] - borrow;
+            borrow = diff < 0;
+            out[i] = static_cast<uint32_t>(diff);
+        }
+    }
+    else {
+        std::copy(t, t + k, out);
+    }
+}
+
+void MontgomeryContext::add(const uint32_t* a, const uint32_t* b, uint32_t* out) const {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < k; ++i) {
+        uint64_t sum = static_cast<uint64_t>(a[i]) + b[i] + carry;
+        out[i] = static_cast<uint32_t>(sum);
+        carry = sum >> 32;
+    }
+    bool geq = carry != 0;
+    if (!geq) {
+        geq = true;
+        for (size_t i = k; i-- > 0;) {
+            if (out[i] != nWords[i]) { geq = out[i] > nWords[i]; break; }
+        }
+    }
+    if (geq) {
+        int64_t borrow = 0;
+        for (size_t i = 0; i < k; ++i) {
+            int64_t diff = static_cast<int64_t>(out[i]) - nWords[i] - borrow;
+            borrow = diff < 0;
+            out[i] = static_cast<uint32_t>(diff);
+        }
+    }
+}
+
+void MontgomeryContext::sub(const uint32_t* a, const uint32_t* b, uint32_t* out) const {
+    int64_t borrow = 0;
+    for (size_t i = 0; i < k; ++i) {
+        int64_t diff = static_cast<int64_t>(a[i]) - b[i] - borrow;
+        borrow = diff < 0;
+        out[i] = static_cast<uint32_t>(diff);
+    }
+    if (borrow) {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < k; ++i) {
+            uint64_t sum = static_cast<uint64_t>(out[i]) + nWords[i] + carry;
+            out[i] = static_cast<uint32_t>(sum);
+            carry = sum >> 32;
+        }
+    }
+}
+
+std::vector<uint32_t> MontgomeryContext::toMontgomery(const BigUInt& x) const {
+    std::vector<uint32_t> res(k, 0);
+    BigUInt reduced = (x < n) ? x : x % n;
+    std::span<const uint32_t> w = reduced.words();
+    std::copy(w.begin(), w.end(), res.begin());
+    mul(res.data(), r2ModN.data(), res.data());
+    return res;
+}
+
+BigUInt MontgomeryContext::fromMontgomery(const std::vector<uint32_t>& x) const {
+    std::vector<uint32_t> unit(k, 0), res(k, 0);
+    unit[0] = 1;
+    mul(x.data(), unit.data(), res.data());
+    return BigUInt::fromWords(res);
+}
+
+// ModInt
+
+ModInt::ModInt(std::shared_ptr<const MontgomeryContext> ctx, const BigUInt& value)
+    : ctx(std::move(ctx)) {
+    if (!this->ctx) throw std::runtime_error("ModInt requires a modulus context");
+    this->value = this->ctx->toMontgomery(value);
+}
+
+ModInt::ModInt(const BigUInt& modulus, const BigUInt& value)
+    : ModInt(MontgomeryContext::create(modulus), value) {
+}
+
+ModInt::ModInt(std::shared_ptr<const MontgomeryContext> ctx, std::vector<uint32_t> mont)
+    : ctx(std::move(ctx)), value(std::move(mont)) {
+}
+
+void ModInt::checkContext(const ModInt& other) const {
+    if (ctx != other.ctx && ctx->modulus() != other.ctx->modulus()) {
+        throw std::runtime_error("ModInt operands have different moduli");
+    }
+}
+
+ModInt& ModInt::operator+=(const ModInt& other) {
+    checkContext(other);
+    ctx->add(value.data(), other.value.data(), value.data());
+    return *this;
+}
+
+ModInt& ModInt::operator-=(const ModInt& other) {
+    checkContext(other);
+    ctx->sub(value.data(), other.value.data(), value.data());
+    return *this;
+}
+
+ModInt& ModInt::operator*=(const ModInt& other) {
+    checkContext(other);
+    ctx->mul(value.data(), other.value.data(), value.data());
+    return *this;
+}
+
+ModInt ModInt::operator+(const ModInt& other) const { ModInt res = *this; res += other; return res; }
+ModInt ModInt::operator-(const ModInt& other) const { ModInt res = *this; res -= other; return res; }
+ModInt ModInt::operator*(const ModInt& other) const { ModInt res = *this; res *= other; return res; }
+
+bool ModInt::operator==(const ModInt& other) const {
+    checkContext(other);
+    return value == other.value;
+}
+
+bool ModInt::operator!=(const ModInt& other) const { return !(*this == other); }
+
+// Left-to-right fixed 4-bit windows over a table of x^0 .. x^15.
+ModInt ModInt::pow(const BigUInt& exponent) const {
+    size_t k = ctx->size();
+    std::vector<std::vector<uint32_t>> table(16);
+    table[0] = ctx->one();
+    table[1] = value;
+    for (size_t i = 2; i < 16; ++i) {
+        table[i].resize(k);
+        ctx->mul(table[i - 1].data(), value.data(), table[i].data());
+    }
+
+    std::vector<uint32_t> res = ctx->one();
+    int bits = exponent.bitLength();
+    for (int pos = ((bits + 3) / 4) * 4 - 4; pos >= 0; pos -= 4) {
+        for (int s = 0; s < 4; ++s) ctx->mul(res.data(), res.data(), res.data());
+        int w = 0;
+        for (int b = 3; b >= 0; --b) w = (w << 1) | (exponent.getBit(pos + b) ? 1 : 0);
+        if (w) ctx->mul(res.data(), table[w].data(), res.data());
+    }
+    return ModInt(ctx, std::move(res));
+}
+
+BigUInt ModInt::toBigUInt() const { return ctx->fromMontgomery(value); }
+std::string ModInt::toDec() const { return toBigUInt().toDec(); }
+std::string ModInt::toHex() const { return toBigUInt().toHex(); }
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "BigUInt.hpp"
+
+// Precomputed data for Montgomery arithmetic modulo an odd n of k words,
+// with R = 2^(32k). Immutable once built, so one instance can be shared by
+// any number of ModInt values and threads.
+class MontgomeryContext {
+public:
+    explicit MontgomeryContext(const BigUInt& n);
+    static std::shared_ptr<const MontgomeryContext> create(const BigUInt& n);
+
+    const BigUInt& modulus() const { return n; }
+    size_t size() const { return k; }
+
+    // Word-level kernels on k-word operands that are already reduced mod n.
+    void mul(const uint32_t* a, const uint32_t* b, uint32_t* out) const;   // a * b * R^-1 mod n
+    void add(const uint32_t* a, const uint32_t* b, uint32_t* out) const;
+    void sub(const uint32_t* a, const uint32_t* b, uint32_t* out) const;
+
+    std::vector<uint32_t> toMontgomery(const BigUInt& x) const;
+    BigUInt fromMontgomery(const std::vector<uint32_t>& x) const;
+    const std::vector<uint32_t>& one() const { return rModN; }
+
+private:
+    BigUInt n;
+    size_t k;
+    std::vector<uint32_t> nWords;
+    uint32_t nInv;                  // -n^-1 mod 2^32
+    std::vector<uint32_t> rModN;    // R mod n, i.e. 1 in Montgomery form
+    std::vector<uint32_t> r2ModN;   // R^2 mod n
+};
+
+// Residue modulo the context's n, kept in Montgomery form. Conversion in
+// happens at construction and conversion out only in toBigUInt()/toDec()/
+// toHex(), so chains of operations pay for it once.
+class ModInt {
+public:
+    ModInt(std::shared_ptr<const MontgomeryContext> ctx, const BigUInt& value);
+    ModInt(const BigUInt& modulus, const BigUInt& value);
+
+    ModInt operator+(const ModInt& other) const;
+    ModInt operator-(const ModInt& other) const;
+    ModInt operator*(const ModInt& other) const;
+    ModInt& operator+=(const ModInt& other);
+    ModInt& operator-=(const ModInt& other);
+    ModInt& operator*=(const ModInt& other);
+    bool operator==(const ModInt& other) const;
+    bool operator!=(const ModInt& other) const;
+
+    ModInt pow(const BigUInt& exponent) const;
+
+    BigUInt toBigUInt() const;
+    std::string toDec() const;
+    std::string toHex() const;
+
+    const std::shared_ptr<const MontgomeryContext>& context() const { return ctx; }
+
+private:
+    ModInt(std::shared_ptr<const MontgomeryContext> ctx, std::vector<uint32_t> mont);
+    void checkContext(const ModInt& other) const;
+
+    std::shared_ptr<const MontgomeryContext> ctx;
+    std::vector<uint32_t> value;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// Levels of a product or remainder tree whose total size is below this many
+// words run serially; spawning threads for them costs more than the work.
+inline constexpr size_t PARALLEL_LEVEL_WORDS = 2048;
+
+// Spare hardware threads for nested fork-join work, such as the sub-products
+// of one large multiplication. tryAcquireThread() takes one if any is left,
+// and the caller hands it back with releaseThread() after joining; the
+// SpareThread guard below does both.
+inline std::atomic<int>& spareThreads() {
+    static std::atomic<int> spare(static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) - 1);
+    return spare;
+}
+
+inline bool tryAcquireThread() {
+    std::atomic<int>& spare = spareThreads();
+    int n = spare.load(std::memory_order_relaxed);
+    while (n > 0) {
+        if (spare.compare_exchange_weak(n, n - 1, std::memory_order_acquire, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+inline void releaseThread() {
+    spareThreads().fetch_add(1, std::memory_order_release);
+}
+
+// Holds one spare thread, if one was free, until it goes out of scope.
+class SpareThread {
+public:
+    SpareThread() : held(tryAcquireThread()) {}
+    ~SpareThread() { if (held) releaseThread(); }
+    SpareThread(const SpareThread&) = delete;
+    SpareThread& operator=(const SpareThread&) = delete;
+
+    explicit operator bool() const { return held; }
+
+private:
+    bool held;
+};
+
+// Runs f(i) for i in [0, count) on up to hardware_concurrency() threads.
+// Indices are handed out one at a time, so uneven work items balance out.
+// Each call starts and joins its own threads; there is no persistent pool.
+// Callers use it once per product/remainder tree level, where the tens of
+// microseconds of thread start-up are small next to the level's arithmetic.
+template<typename F>
+void parallelFor(size_t count, F f) {
+    size_t threads = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) f(i);
+        return;
+    }
+
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) f(i);
+    };
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < threads; ++t) helpers.emplace_back(worker);
+    worker();
+    for (std::thread& t : helpers) t.join();
+}
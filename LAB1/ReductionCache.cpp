@@ -0,0 +1,137 @@
+#include "ReductionCache.hpp"
+#include <stdexcept>
+
+const BarrettContext& ReductionContext::barrett() const {
+    std::call_once(barrettOnce, [this]() { barrettContext = std::make_unique<const BarrettContext>(modulus); });
+    return *barrettContext;
+}
+
+static size_t setCount(size_t capacity) {
+    size_t sets = 1;
+    while (sets * ReductionCache::WAYS < capacity) sets <<= 1;
+    return sets;
+}
+
+ReductionCache::ReductionCache(size_t capacity)
+    : setMask(setCount(capacity) - 1), slots(setCount(capacity) * WAYS), sets(setCount(capacity)) {
+}
+
+ReductionCache::~ReductionCache() {
+    for (auto& slot : slots) delete slot.load(std::memory_order_relaxed);
+    for (Set& s : sets) {
+        for (Entry* e : s.retired) delete e;
+    }
+}
+
+ReductionCache& ReductionCache::global() {
+    static ReductionCache cache;
+    return cache;
+}
+
+// splitmix64 finalizer folded over the limbs.
+uint64_t ReductionCache::hash(const BigUInt& n) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL;
+    for (uint32_t w : n.words()) {
+        h ^= w;
+        h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+// The slot loads are sequentially consistent with the reader counter and
+// the publishing exchange: a reader that registered after reclaim() saw an
+// empty counter is guaranteed to load the replacement, not the retired entry.
+ReductionCache::Entry* ReductionCache::find(size_t set, uint64_t h, const BigUInt& n) const {
+    for (size_t w = 0; w < WAYS; ++w) {
+        Entry* e = slots[set * WAYS + w].load();
+        if (e && e->ctx->hash == h && e->ctx->modulus == n) return e;
+    }
+    return nullptr;
+}
+
+// Frees retired entries once no reader can still hold one. Called with the
+// set's mutex held.
+void ReductionCache::reclaim(Set& s) {
+    if (s.retired.empty() || s.readers.load() != 0) return;
+    for (Entry* e : s.retired) delete e;
+    s.retired.clear();
+}
+
+std::shared_ptr<const ReductionContext> ReductionCache::get(const BigUInt& n) {
+    if (n == BigUInt(0)) throw std::runtime_error("Modulo by zero");
+    uint64_t h = hash(n);
+    size_t set = static_cast<size_t>(h) & setMask;
+    Set& s = sets[set];
+
+    std::shared_ptr<const ReductionContext> found;
+    s.readers.fetch_add(1);
+    if (Entry* e = find(set, h, n)) {
+        found = e->ctx;
+        uint64_t now = clock.load(std::memory_order_relaxed);
+        if (e->lastUse.load(std::memory_order_relaxed) != now) e->lastUse.store(now, std::memory_order_relaxed);
+    }
+    s.readers.fetch_sub(1, std::memory_order_release);
+    if (found) {
+        s.hits.fetch_add(1, std::memory_order_relaxed);
+        return found;
+    }
+    s.misses.fetch_add(1, std::memory_order_relaxed);
+
+    auto ctx = std::make_shared<ReductionContext>();
+    ctx->modulus = n;
+    ctx->hash = h;
+    if (n.getBit(0) && n != BigUInt(1)) ctx->montgomery = MontgomeryContext::create(n);
+    ctx->special = PseudoMersenneContext::detect(n);
+
+    std::lock_guard<std::mutex> lock(s.lock);
+    if (Entry* e = find(set, h, n)) return e->ctx;
+
+    size_t victim = set * WAYS;
+    uint64_t oldest = UINT64_MAX;
+    for (size_t w = 0; w < WAYS; ++w) {
+        Entry* e = slots[set * WAYS + w].load(std::memory_order_relaxed);
+        if (!e) { victim = set * WAYS + w; break; }
+        uint64_t used = e->lastUse.load(std::memory_order_relaxed);
+        if (used < oldest) { oldest = used; victim = set * WAYS + w; }
+    }
+
+    Entry* entry = new Entry{ ctx, clock.fetch_add(1, std::memory_order_relaxed) + 1 };
+    if (Entry* old = slots[victim].exchange(entry)) s.retired.push_back(old);
+    reclaim(s);
+    return ctx;
+}
+
+uint64_t ReductionCache::hits() const {
+    uint64_t total = 0;
+    for (const Set& s : sets) total += s.hits.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t ReductionCache::misses() const {
+    uint64_t total = 0;
+    for (const Set& s : sets) total += s.misses.load(std::memory_order_relaxed);
+    return total;
+}
+
+size_t ReductionCache::size() const {
+    size_t count = 0;
+    for (const auto& slot : slots) {
+        if (slot.load(std::memory_order_relaxed)) ++count;
+    }
+    return count;
+}
+
+void ReductionCache::clear() {
+    for (size_t set = 0; set < sets.size(); ++set) {
+        Set& s = sets[set];
+        std::lock_guard<std::mutex> lock(s.lock);
+        for (size_t w = 0; w < WAYS; ++w) {
+            if (Entry* old = slots[set * WAYS + w].exchange(nullptr)) s.retired.push_back(old);
+        }
+        reclaim(s);
+        s.hits.store(0, std::memory_order_relaxed);
+        s.misses.store(0, std::memory_order_relaxed);
+    }
+}
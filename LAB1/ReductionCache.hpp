@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "BigUInt.hpp"
+#include "ModInt.hpp"
+#include "SpecialModulus.hpp"
+
+// Barrett constants for one modulus.
+class BarrettContext {
+public:
+    explicit BarrettContext(const BigUInt& n) : n(n), mu(BigUInt::calculateBarrettMu(n)) {}
+
+    const BigUInt& modulus() const { return n; }
+    const BigUInt& barrettMu() const { return mu; }
+    BigUInt reduce(const BigUInt& x) const { return BigUInt::barrettReduction(x, n, mu); }
+
+private:
+    BigUInt n;
+    BigUInt mu;
+};
+
+// Everything precomputed for one modulus. montgomery is null for even
+// moduli, special is null unless the modulus has the form 2^k - c. The
+// Barrett constants cost a full division and only some callers want them,
+// so they are built on first use.
+struct ReductionContext {
+    BigUInt modulus;
+    uint64_t hash = 0;
+    std::shared_ptr<const MontgomeryContext> montgomery;
+    std::shared_ptr<const PseudoMersenneContext> special;
+
+    const BarrettContext& barrett() const;
+
+private:
+    mutable std::once_flag barrettOnce;
+    mutable std::unique_ptr<const BarrettContext> barrettContext;
+};
+
+// Bounded, thread-safe cache of immutable per-modulus contexts.
+//
+// The table is set-associative: a modulus hashes to one set of WAYS slots
+// and is evicted LRU within that set. Slots hold raw entry pointers, so a
+// hit takes no lock: it announces itself on the set's reader counter, scans
+// the ways and copies the context's shared_ptr. Misses build the context
+// outside any lock and take the set's mutex only to publish it. Evicted
+// entries are retired and freed on a later miss in the same set once no
+// reader is inside it, or when the cache is cleared or destroyed.
+//
+// Recency is a per-entry timestamp taken from a clock that only misses
+// advance; hits store it with a relaxed write, and only when it changed.
+class ReductionCache {
+public:
+    static constexpr size_t WAYS = 8;
+
+    explicit ReductionCache(size_t capacity = 512);
+    ~ReductionCache();
+    ReductionCache(const ReductionCache&) = delete;
+    ReductionCache& operator=(const ReductionCache&) = delete;
+    static ReductionCache& global();
+
+    std::shared_ptr<const ReductionContext> get(const BigUInt& n);
+
+    uint64_t hits() const;
+    uint64_t misses() const;
+    size_t capacity() const { return slots.size(); }
+    size_t size() const;
+    void clear();
+
+    static uint64_t hash(const BigUInt& n);
+
+private:
+    struct Entry {
+        std::shared_ptr<const ReductionContext> ctx;
+        std::atomic<uint64_t> lastUse;
+    };
+
+    // Per-set state, padded so that sets used by different threads do not
+    // share a cache line.
+    struct alignas(64) Set {
+        std::atomic<uint32_t> readers{ 0 };
+        std::atomic<uint64_t> hits{ 0 };
+        std::atomic<uint64_t> misses{ 0 };
+        std::mutex lock;
+        std::vector<Entry*> retired;
+    };
+
+    Entry* find(size_t set, uint64_t h, const BigUInt& n) const;
+    void reclaim(Set& s);
+
+    size_t setMask;
+    std::vector<std::atomic<Entry*>> slots;
+    std::vector<Set> sets;
+    std::atomic<uint64_t> clock{ 0 };
+};
@@ -0,0 +1,148 @@
+#include "SpecialModulus.hpp"
+#include <bit>
+#include <stdexcept>
+#include "Limbs.hpp"
+
+static size_t significantWords(const std::vector<uint32_t>& x) {
+    size_t n = x.size();
+    while (n > 0 && x[n - 1] == 0) --n;
+    return n;
+}
+
+PseudoMersenneContext::PseudoMersenneContext(int k, const BigUInt& c) : k(k), c(c) {
+    if (k < 2 || c == BigUInt(0) || c.bitLength() >= k) {
+        throw std::runtime_error("Pseudo-Mersenne modulus needs 0 < c < 2^(k-1)");
+    }
+    n = (BigUInt(1) << k) - c;
+    std::span<const uint32_t> cw = c.words(), nw = n.words();
+    cWords.assign(cw.begin(), cw.end());
+    nWords.assign(nw.begin(), nw.end());
+}
+
+std::shared_ptr<const PseudoMersenneContext> PseudoMersenneContext::create(int k, const BigUInt& c) {
+    return std::make_shared<const PseudoMersenneContext>(k, c);
+}
+
+// n = 2^k - c with bitLength(c) <= h = k / 2 exactly when bits h..k-1 of n
+// are all ones and some bit below h is set (n = 2^k - 2^h has c = 2^h).
+bool PseudoMersenneContext::hasSpecialForm(std::span<const uint32_t> n) {
+    if (n.size() < 2) return false;
+    uint32_t top = n.back();
+    if (top == 0 || (top & (top + 1)) != 0) return false;
+
+    int k = 32 * static_cast<int>(n.size() - 1) + std::bit_width(top);
+    size_t hw = static_cast<size_t>(k / 2) / 32;
+    int hb = (k / 2) % 32;
+    for (size_t i = hw + 1; i + 1 < n.size(); ++i) {
+        if (n[i] != 0xFFFFFFFF) return false;
+    }
+    if (hw + 1 < n.size()) {
+        uint32_t mask = ~0u << hb;
+        if ((n[hw] & mask) != mask) return false;
+    }
+    for (size_t i = 0; i < hw; ++i) {
+        if (n[i] != 0) return true;
+    }
+    return hb != 0 && (n[hw] & ((1u << hb) - 1)) != 0;
+}
+
+std::shared_ptr<const PseudoMersenneContext> PseudoMersenneContext::detect(const BigUInt& n) {
+    if (!hasSpecialForm(n.words())) return nullptr;
+    int k = n.bitLength();
+    return create(k, (BigUInt(1) << k) - n);
+}
+
+void PseudoMersenneContext::reduce(std::vector<uint32_t>& x, std::vector<uint32_t>& hi, std::vector<uint32_t>& prod) const {
+    size_t kWords = static_cast<size_t>(k + 31) / 32;
+    size_t wordShift = static_cast<size_t>(k) / 32;
+    int bitShift = k % 32;
+
+    for (;;) {
+        size_t len = significantWords(x);
+        x.resize(std::max<size_t>(len, 1));
+        if (len < kWords || (len == kWords && (bitShift == 0 || (x[len - 1] >> bitShift) == 0))) break;
+
+        // hi = x >> k, x = x mod 2^k
+        hi.assign(len - wordShift, 0);
+        for (size_t i = 0; i < hi.size(); ++i) {
+            uint32_t lo = x[i + wordShift] >> bitShift;
+            uint32_t up = (bitShift && i + wordShift + 1 < len) ? x[i + wordShift + 1] << (32 - bitShift) : 0;
+            hi[i] = lo | up;
+        }
+        x.resize(kWords);
+        if (bitShift) x[kWords - 1] &= (1u << bitShift) - 1;
+
+        // x += hi * c
+        mulLimbs(hi, cWords, prod);
+        x.resize(std::max(kWords, prod.size()) + 1, 0);
+        addLimbs(x.data(), x.size(), prod.data(), prod.size());
+    }
+
+    // Now x < 2^k < 2n, so one subtraction finishes the job.
+    bool geq = x.size() >= nWords.size();
+    if (geq && x.size() == nWords.size()) {
+        for (size_t i = x.size(); i-- > 0;) {
+            if (x[i] != nWords[i]) { geq = x[i] > nWords[i]; break; }
+        }
+    }
+    if (geq) {
+        subLimbs(x.data(), x.size(), nWords.data(), nWords.size());
+        x.resize(std::max<size_t>(significantWords(x), 1));
+    }
+}
+
+void PseudoMersenneContext::reduce(std::vector<uint32_t>& x) const {
+    std::vector<uint32_t> hi, prod;
+    reduce(x, hi, prod);
+}
+
+BigUInt PseudoMersenneContext::reduce(const BigUInt& x) const {
+    std::span<const uint32_t> w = x.words();
+    std::vector<uint32_t> v(w.begin(), w.end());
+    reduce(v);
+    return BigUInt::fromWords(v);
+}
+
+BigUInt PseudoMersenneContext::mulMod(const BigUInt& a, const BigUInt& b) const {
+    std::span<const uint32_t> aw = a.words(), bw = b.words();
+    std::vector<uint32_t> out(aw.size() + bw.size(), 0);
+    mulLimbs(aw.data(), aw.size(), bw.data(), bw.size(), out.data());
+    reduce(out);
+    return BigUInt::fromWords(out);
+}
+
+// Left-to-right fixed 4-bit windows; all scratch buffers are reused.
+BigUInt PseudoMersenneContext::powMod(const BigUInt& base, const BigUInt& exponent) const {
+    std::vector<uint32_t> hi, prod, fold;
+    std::vector<std::vector<uint32_t>> table(16);
+    table[0] = { 1 };
+    std::span<const uint32_t> bw = base.words();
+    table[1].assign(bw.begin(), bw.end());
+    reduce(table[1], hi, fold);
+    for (size_t i = 2; i < 16; ++i) {
+        mulLimbs(table[i - 1], table[1], table[i]);
+        reduce(table[i], hi, fold);
+    }
+
+    std::vector<uint32_t> res = { 1 };
+    int bits = exponent.bitLength();
+    bool started = false;
+    for (int pos = ((bits + 3) / 4) * 4 - 4; pos >= 0; pos -= 4) {
+        if (started) {
+            for (int s = 0; s < 4; ++s) {
+                sqrLimbs(res, prod);
+                reduce(prod, hi, fold);
+                res.swap(prod);
+            }
+        }
+        int w = 0;
+        for (int b = 3; b >= 0; --b) w = (w << 1) | (exponent.getBit(pos + b) ? 1 : 0);
+        if (w) {
+            mulLimbs(res, table[w], prod);
+            reduce(prod, hi, fold);
+            res.swap(prod);
+            started = true;
+        }
+    }
+    return BigUInt::fromWords(res);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+#include "BigUInt.hpp"
+
+// Reduction modulo n = 2^k - c for a positive c below 2^(k-1). Since
+// 2^k = c (mod n), x = hi * 2^k + lo folds to hi * c + lo, which costs a
+// shift and a short multiply-add per step instead of a division. Mersenne
+// (c = 1) and pseudo-Mersenne (c of a word or two) moduli fold in one or two
+// steps; generalized forms with a longer c can be declared too, each fold
+// then removes k - bitLength(c) bits.
+class PseudoMersenneContext {
+public:
+    PseudoMersenneContext(int k, const BigUInt& c);
+    static std::shared_ptr<const PseudoMersenneContext> create(int k, const BigUInt& c);
+
+    // Returns a context when n is a multi-word 2^k - c with bitLength(c) <= k / 2, null otherwise.
+    static std::shared_ptr<const PseudoMersenneContext> detect(const BigUInt& n);
+    // Exact test on the words, no allocation: true iff detect() would succeed.
+    static bool hasSpecialForm(std::span<const uint32_t> n);
+
+    const BigUInt& modulus() const { return n; }
+    const BigUInt& offset() const { return c; }
+    int bits() const { return k; }
+
+    BigUInt reduce(const BigUInt& x) const;
+    void reduce(std::vector<uint32_t>& x) const;
+    BigUInt mulMod(const BigUInt& a, const BigUInt& b) const;
+    BigUInt powMod(const BigUInt& base, const BigUInt& exponent) const;
+
+private:
+    void reduce(std::vector<uint32_t>& x, std::vector<uint32_t>& hi, std::vector<uint32_t>& prod) const;
+
+    int k;
+    BigUInt c;
+    BigUInt n;
+    std::vector<uint32_t> cWords;
+    std::vector<uint32_t> nWords;
+};
@@ -0,0 +1,257 @@
+#include "batch.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "BigUInt.hpp"
+#include "BigUIntArray.hpp"
+
+using namespace std;
+
+namespace {
+
+    struct Job {
+        uint64_t index = 0;
+        string op;
+        vector<BigUInt> args;
+        string error;
+    };
+
+    template<typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+        void push(T item) {
+            unique_lock<mutex> lock(m);
+            notFull.wait(lock, [&]() { return items.size() < capacity; });
+            items.push_back(std::move(item));
+            notEmpty.notify_one();
+        }
+
+        bool pop(T& item) {
+            unique_lock<mutex> lock(m);
+            notEmpty.wait(lock, [&]() { return !items.empty() || closed; });
+            if (items.empty()) return false;
+            item = std::move(items.front());
+            items.pop_front();
+            notFull.notify_one();
+            return true;
+        }
+
+        void close() {
+            lock_guard<mutex> lock(m);
+            closed = true;
+            notEmpty.notify_all();
+        }
+
+    private:
+        size_t capacity;
+        deque<T> items;
+        bool closed = false;
+        mutex m;
+        condition_variable notFull, notEmpty;
+    };
+
+    // Reorder buffer between the workers and the writer. The parser reserves
+    // a slot before emitting job i, which blocks while i is more than
+    // `capacity` ahead of the last written result.
+    class OrderedOutput {
+    public:
+        explicit OrderedOutput(size_t capacity) : slots(capacity) {}
+
+        void reserve(uint64_t index) {
+            unique_lock<mutex> lock(m);
+            slotFree.wait(lock, [&]() { return index < next + slots.size(); });
+        }
+
+        void put(uint64_t index, string text) {
+            lock_guard<mutex> lock(m);
+            slots[index % slots.size()] = std::move(text);
+            if (index == next) ready.notify_one();
+        }
+
+        void finish(uint64_t total) {
+            lock_guard<mutex> lock(m);
+            this->total = total;
+            ready.notify_one();
+        }
+
+        // Returns false once every result has been written.
+        bool pop(string& text) {
+            unique_lock<mutex> lock(m);
+            auto& slot = slots[next % slots.size()];
+            ready.wait(lock, [&]() { return slot.has_value() || (total && next == *total); });
+            if (!slot.has_value()) return false;
+            text = std::move(*slot);
+            slot.reset();
+            ++next;
+            slotFree.notify_one();
+            return true;
+        }
+
+    private:
+        vector<optional<string>> slots;
+        uint64_t next = 0;
+        optional<uint64_t> total;
+        mutex m;
+        condition_variable ready, slotFree;
+    };
+
+    size_t arity(const string& op) {
+        if (op == "powmod") return 3;
+        if (op == "add" || op == "sub" || op == "mul" || op == "div" || op == "mod" ||
+            op == "pow" || op == "gcd" || op == "lcm") return 2;
+        return 0;
+    }
+
+    Job parse_line(uint64_t index, const string& line) {
+        Job job;
+        job.index = index;
+        istringstream ss(line);
+        ss >> job.op;
+        size_t n = arity(job.op);
+        if (n == 0) { job.error = "unknown operation '" + job.op + "'"; return job; }
+
+        string token;
+        while (ss >> token) {
+            if (!BigUInt::isNumber(token)) { job.error = "invalid number '" + token + "'"; return job; }
+            job.args.emplace_back(token);
+        }
+        if (job.args.size() != n) job.error = job.op + " expects " + to_string(n) + " arguments";
+        return job;
+    }
+
+    // base^e has at least (bitLength(base) - 1) * e + 1 bits for base > 1.
+    bool powFits(const BigUInt& base, const BigUInt& e) {
+        if (base <= BigUInt(1)) return true;
+        if (e.bitLength() > 32) return false;
+        uint64_t exp = e.words()[0];
+        return static_cast<uint64_t>(base.bitLength() - 1) * exp < static_cast<uint64_t>(BatchOptions::MAX_RESULT_BITS);
+    }
+
+    string evaluate(const Job& job) {
+        if (!job.error.empty()) return "error: " + job.error;
+        try {
+            const vector<BigUInt>& a = job.args;
+            if (job.op == "powmod") return a[0].powMod(a[1], a[2]).toDec();
+            if (job.op == "add") return (a[0] + a[1]).toDec();
+            if (job.op == "sub") return (a[0] - a[1]).toDec();
+            if (job.op == "mul") return (a[0] * a[1]).toDec();
+            if (job.op == "div") return (a[0] / a[1]).toDec();
+            if (job.op == "mod") return (a[0] % a[1]).toDec();
+            if (job.op == "pow") {
+                if (!powFits(a[0], a[1])) return "error: pow result exceeds " + to_string(BatchOptions::MAX_RESULT_BITS) + " bits";
+                return a[0].pow(a[1]).toDec();
+            }
+            if (job.op == "gcd") return BigUInt::gcd(a[0], a[1]).toDec();
+            if (job.op == "lcm") return BigUInt::lcm(a[0], a[1]).toDec();
+            return "error: unknown operation '" + job.op + "'";
+        }
+        catch (const exception& ex) {
+            return string("error: ") + ex.what();
+        }
+    }
+
+    template<typename Emit>
+    void parse_text(istream& in, Emit emit) {
+        uint64_t count = 0;
+        string line;
+        while (getline(in, line)) {
+            size_t start = line.find_first_not_of(" \t\r");
+            if (start == string::npos || line[start] == '#') continue;
+            emit(parse_line(count++, line));
+        }
+    }
+
+    template<typename Emit>
+    void parse_binary(const string& path, Emit emit) {
+        MappedBigUIntArray arr(path);
+        if (arr.size() % 3 != 0) throw runtime_error("binary input must hold (base, exp, mod) triples");
+        uint64_t count = 0;
+        for (size_t i = 0; i < arr.size(); i += 3) {
+            Job job;
+            job.index = count++;
+            job.op = "powmod";
+            job.args = { arr.at(i), arr.at(i + 1), arr.at(i + 2) };
+            emit(std::move(job));
+        }
+    }
+}
+
+int run_batch(const BatchOptions& options) {
+    if (options.threads > BatchOptions::MAX_THREADS) throw invalid_argument("too many threads");
+    if (options.window > BatchOptions::MAX_WINDOW) throw invalid_argument("window too large");
+    unsigned threads = options.threads ? options.threads : max(1u, thread::hardware_concurrency());
+    size_t window = max<size_t>(options.window, threads);
+
+    BoundedQueue<Job> jobs(window);
+    OrderedOutput output(window);
+    string parseError;
+
+    auto start = chrono::steady_clock::now();
+
+    thread parser([&]() {
+        uint64_t total = 0;
+        auto emit = [&](Job job) {
+            output.reserve(job.index);
+            jobs.push(std::move(job));
+            ++total;
+        };
+        try {
+            if (options.binary) {
+                parse_binary(options.input, emit);
+            }
+            else if (options.input == "-") {
+                parse_text(cin, emit);
+            }
+            else {
+                ifstream file(options.input);
+                if (!file) throw runtime_error("cannot open " + options.input);
+                parse_text(file, emit);
+            }
+        }
+        catch (const exception& ex) {
+            parseError = ex.what();
+        }
+        jobs.close();
+        output.finish(total);
+    });
+
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back([&]() {
+            Job job;
+            while (jobs.pop(job)) output.put(job.index, evaluate(job));
+        });
+    }
+
+    uint64_t written = 0;
+    string text;
+    while (output.pop(text)) {
+        cout << text << '\n';
+        ++written;
+    }
+    cout.flush();
+
+    parser.join();
+    for (thread& t : workers) t.join();
+
+    auto us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    double seconds = us / 1e6;
+    cerr << "Processed " << written << " ops in " << seconds << " s on " << threads << " threads ("
+        << (seconds > 0 ? written / seconds : 0.0) << " ops/sec)\n";
+
+    if (!parseError.empty()) {
+        cerr << "Input error: " << parseError << endl;
+        return 1;
+    }
+    return 0;
+}
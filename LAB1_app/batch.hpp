@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+struct BatchOptions {
+    static constexpr unsigned MAX_THREADS = 1024;
+    static constexpr size_t MAX_WINDOW = size_t(1) << 20;
+    static constexpr int MAX_RESULT_BITS = 1 << 24;   // pow results larger than this are refused
+
+    std::string input = "-";        // "-" reads from stdin
+    bool binary = false;            // input is a BigUIntArray file of (base, exp, mod) triples
+    unsigned threads = 0;           // 0 = hardware concurrency
+    size_t window = 4096;           // max operations in flight between parser and writer
+};
+
+// Reads one operation per line ("powmod <b> <e> <m>", "add <a> <b>", ...),
+// evaluates them on a worker pool and prints the results in input order.
+int run_batch(const BatchOptions& options);
@@ -2,8 +2,14 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <stdexcept>
 #include <cassert>
 #include "BigUInt.hpp"
+#include "FixedBasePow.hpp"
+#include "ModInt.hpp"
+#include "ReductionCache.hpp"
+#include "SpecialModulus.hpp"
+#include "batch.hpp"
 
 using namespace std;
 
@@ -88,7 +94,7 @@ void demo_variant8() {
 
     BigUInt R = BigUInt::getMontgomeryR(N);
     BigUInt n_prime = BigUInt::calculateMontgomeryInverse(N, R);
-    BigUInt A_mont = (A * R) % N;
+    BigUInt A_mont = BigUInt::mulMod(A, R, N);
 
     auto tMont = measure_time([&]() {
         for (int i = 0; i < iterations; ++i) {
@@ -102,6 +108,115 @@ void demo_variant8() {
 
     if (resStd == resMont) cout << "[VERIFY]\n";
     else cout << "[ERROR] Montgomery mismatch!\n";
+
+    cout << "\nChain of " << iterations << " modular multiplications:\n\n";
+    BigUInt B = N - BigUInt("0x123456789ABCDEF");
+    BigUInt chainStd(1), chainMod;
+    auto ctx = MontgomeryContext::create(N);
+
+    auto tChainStd = measure_time([&]() {
+        for (int i = 0; i < iterations; ++i) chainStd = BigUInt::mulMod(chainStd, B, N);
+        });
+    cout << "1. mulMod:                 " << tChainStd << " us\n";
+
+    auto tChainMod = measure_time([&]() {
+        ModInt acc(ctx, BigUInt(1)), b(ctx, B);
+        for (int i = 0; i < iterations; ++i) acc *= b;
+        chainMod = acc.toBigUInt();
+        });
+    cout << "2. ModInt (Montgomery):    " << tChainMod << " us  (Speedup: " << (double)tChainStd / tChainMod << "x)\n";
+
+    if (chainStd == chainMod) cout << "\n[VERIFY]\n";
+    else cout << "\n[ERROR] ModInt mismatch!\n";
+
+    BigUInt P = (BigUInt(1) << 512) - BigUInt(15);
+    auto special = PseudoMersenneContext::detect(P);
+    BigUInt X = (P - BigUInt("0x123456789ABCDEF")) * (P - BigUInt("0xFEDCBA987654321"));
+    cout << "\nModulus 2^512 - 15, " << iterations << " reductions:\n\n";
+
+    BigUInt sStd, sBar, sSpec;
+    auto tSStd = measure_time([&]() {
+        for (int i = 0; i < iterations; ++i) sStd = X % P;
+        });
+    cout << "1. Standard Division (%):  " << tSStd << " us\n";
+
+    BarrettContext barrett(P);
+    auto tSBar = measure_time([&]() {
+        for (int i = 0; i < iterations; ++i) sBar = barrett.reduce(X);
+        });
+    cout << "2. Barrett Reduction:      " << tSBar << " us  (Speedup: " << (double)tSStd / tSBar << "x)\n";
+
+    auto tSSpec = measure_time([&]() {
+        for (int i = 0; i < iterations; ++i) sSpec = special->reduce(X);
+        });
+    cout << "3. Special-form Fold:      " << tSSpec << " us  (Speedup: " << (double)tSStd / tSSpec << "x)\n";
+
+    if (sStd == sBar && sStd == sSpec) cout << "\n[VERIFY]\n";
+    else cout << "\n[ERROR] Special-form mismatch!\n";
+
+    cout << "\npowMod with a 512-bit exponent modulo 2^512 - 15:\n\n";
+    BigUInt base = P - BigUInt("0x123456789ABCDEF");
+    BigUInt e = P - BigUInt(2);
+    BigUInt pBar(1), pMont, pSpec;
+    auto montgomery = MontgomeryContext::create(P);
+
+    auto tPBar = measure_time([&]() {
+        BigUInt b = base;
+        for (int i = 0; i < e.bitLength(); ++i) {
+            if (e.getBit(i)) pBar = barrett.reduce(pBar * b);
+            b = barrett.reduce(b * b);
+        }
+        });
+    cout << "1. Barrett:                " << tPBar << " us\n";
+
+    auto tPMont = measure_time([&]() {
+        pMont = ModInt(montgomery, base).pow(e).toBigUInt();
+        });
+    cout << "2. Montgomery (ModInt):    " << tPMont << " us  (Speedup: " << (double)tPBar / tPMont << "x)\n";
+
+    auto tPSpec = measure_time([&]() {
+        pSpec = special->powMod(base, e);
+        });
+    cout << "3. Special-form:           " << tPSpec << " us  (Speedup: " << (double)tPBar / tPSpec << "x)\n";
+
+    if (pBar == pMont && pBar == pSpec) cout << "\n[VERIFY]\n";
+    else cout << "\n[ERROR] powMod mismatch!\n";
+}
+
+void demo_fixed_base() {
+    cout << ("\nFixed-base exponentiation\n");
+
+    BigUInt N("0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1");
+    BigUInt g(3);
+    int iterations = 100;
+
+    vector<BigUInt> exps;
+    BigUInt e("0x0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF"
+        "0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF");
+    for (int i = 0; i < iterations; ++i) {
+        exps.push_back(e);
+        e = BigUInt::mulMod(e, e, N);
+    }
+
+    auto ctx = MontgomeryContext::create(N);
+    ModInt gm(ctx, g);
+    vector<BigUInt> resPow(iterations), resFixed(iterations);
+
+    auto tPow = measure_time([&]() {
+        for (int i = 0; i < iterations; ++i) resPow[i] = gm.pow(exps[i]).toBigUInt();
+        });
+    cout << "1. ModInt::pow:            " << tPow << " us\n";
+
+    FixedBasePow fb(g, N, 512);
+    cout << "   (comb table: " << fb.tableBytes() / 1024 << " KiB)\n";
+    auto tFixed = measure_time([&]() {
+        for (int i = 0; i < iterations; ++i) resFixed[i] = fb.pow(exps[i]);
+        });
+    cout << "2. FixedBasePow:           " << tFixed << " us  (Speedup: " << (double)tPow / tFixed << "x)\n";
+
+    if (resPow == resFixed) cout << "\n[VERIFY]\n";
+    else cout << "\n[ERROR] FixedBasePow mismatch!\n";
 }
 
 void check_identities() {
@@ -115,11 +230,65 @@ void check_identities() {
     cout << "a*c + b*c    = " << right.toDec() << endl;
     cout << (left == right ? "PASSED" : "FAILED") << endl;
 }
-int main() {
+void print_usage() {
+    cerr << "Usage:\n"
+        << "  LAB1_app                          run the demos\n"
+        << "  LAB1_app --batch [file|-]         evaluate text operations, one per line\n"
+        << "  LAB1_app --batch-bin <file>       evaluate powmod over a BigUIntArray of (b, e, m) triples\n"
+        << "Options: --threads <1.." << BatchOptions::MAX_THREADS << ">  --window <1.." << BatchOptions::MAX_WINDOW << ">\n";
+}
+
+// Positive integer in [1, max]; stoul alone would take "-1" as ULONG_MAX.
+size_t parse_count(const string& text, size_t max) {
+    if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != string::npos) {
+        throw invalid_argument("not a count: " + text);
+    }
+    size_t value = stoul(text);
+    if (value < 1 || value > max) throw out_of_range("count out of range: " + text);
+    return value;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        BatchOptions options;
+        bool batch = false;
+        try {
+            for (int i = 1; i < argc; ++i) {
+                string arg = argv[i];
+                if (arg == "--batch") {
+                    batch = true;
+                    if (i + 1 < argc && argv[i + 1][0] != '-') options.input = argv[++i];
+                    else if (i + 1 < argc && string(argv[i + 1]) == "-") ++i;
+                }
+                else if (arg == "--batch-bin" && i + 1 < argc) {
+                    batch = true;
+                    options.binary = true;
+                    options.input = argv[++i];
+                }
+                else if (arg == "--threads" && i + 1 < argc) options.threads = static_cast<unsigned>(parse_count(argv[++i], BatchOptions::MAX_THREADS));
+                else if (arg == "--window" && i + 1 < argc) options.window = parse_count(argv[++i], BatchOptions::MAX_WINDOW);
+                else { print_usage(); return 2; }
+            }
+        }
+        catch (const exception&) {
+            print_usage();
+            return 2;
+        }
+        if (!batch) { print_usage(); return 2; }
+        try {
+            return run_batch(options);
+        }
+        catch (const exception& ex) {
+            cerr << "Batch error: " << ex.what() << endl;
+            return 1;
+        }
+    }
+
     try {
         demo_lab1();
         demo_lab2();
         demo_variant8();
+        demo_fixed_base();
         check_identities();
         cout << "\nAll finish successfully.\n";
     }
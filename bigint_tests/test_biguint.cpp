@@ -2,7 +2,19 @@
 #include <gtest/gtest.h>
 #include <random>
 #include <string>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "BatchGcd.hpp"
 #include "BigUInt.hpp"
+#include "BigUIntArray.hpp"
+#include "CrtContext.hpp"
+#include "FixedBasePow.hpp"
+#include "ModInt.hpp"
+#include "Parallel.hpp"
+#include "ReductionCache.hpp"
+#include "SpecialModulus.hpp"
+#include <thread>
 
 class BigUIntTest : public ::testing::Test {
 protected:
@@ -52,6 +64,14 @@ TEST_F(BigUIntTest, IO_StringDecParsing) {
     EXPECT_EQ(a.toDec(), big);
 }
 
+TEST_F(BigUIntTest, IO_IsNumber) {
+    for (const char* ok : { "0", "12345678901234567890", "0x1", "0XdeadBEEF" }) EXPECT_TRUE(BigUInt::isNumber(ok)) << ok;
+    for (const char* bad : { "", "0x", "-5", "12abc", "+1", "0xg", " 1", "1.0" }) EXPECT_FALSE(BigUInt::isNumber(bad)) << bad;
+
+    // A bare prefix used to leave no limbs at all and crash the division.
+    EXPECT_EQ(BigUInt("0x"), BigUInt(0));
+    EXPECT_THROW(BigUInt(5) % BigUInt("0x"), std::runtime_error);
+}
 
 TEST_F(BigUIntTest, Cmp_Equality) {
     BigUInt a("100");
@@ -197,6 +217,19 @@ TEST_F(BigUIntTest, DivMod_IdentityProperty) {
     }
 }
 
+TEST_F(BigUIntTest, DivMod_LargeOperands) {
+    for (int i = 0; i < 10; ++i) {
+        BigUInt A(randomHex(2000 + rng() % 3000));
+        BigUInt B(randomHex(600 + rng() % 1000));
+
+        BigUInt Q = A / B;
+        BigUInt R = A % B;
+
+        EXPECT_TRUE(R < B);
+        EXPECT_EQ((Q * B) + R, A);
+    }
+}
+
 TEST_F(BigUIntTest, Pow_Basic) {
     BigUInt a("2");
     EXPECT_EQ(a.pow(BigUInt(10)).toDec(), "1024");
@@ -317,6 +350,48 @@ TEST_F(BigUIntTest, BitOps_ShiftRight) {
     EXPECT_EQ(a.toDec(), "512");
 }
 
+TEST_F(BigUIntTest, BitOps_ShiftOperatorsMatchArithmetic) {
+    for (int i = 0; i < 50; ++i) {
+        BigUInt a(randomHex(1 + rng() % 120));
+        int k = static_cast<int>(rng() % 300);
+        BigUInt p = BigUInt(2).pow(BigUInt(k));
+        ASSERT_EQ(a << k, a * p) << "k=" << k;
+        ASSERT_EQ(a >> k, a / p) << "k=" << k;
+        BigUInt b = a;
+        b <<= k;
+        b >>= k;
+        ASSERT_EQ(b, a);
+    }
+    EXPECT_EQ(BigUInt(0) << 100, BigUInt(0));
+    EXPECT_EQ(BigUInt("0xFFFF") >> 64, BigUInt(0));
+}
+
+TEST_F(BigUIntTest, BitOps_LogicalIdentities) {
+    for (int i = 0; i < 50; ++i) {
+        BigUInt a(randomHex(1 + rng() % 100));
+        BigUInt b(randomHex(1 + rng() % 100));
+        BigUInt andAB = a & b, orAB = a | b;
+        ASSERT_EQ(andAB + orAB, a + b);
+        ASSERT_EQ(a ^ b, orAB - andAB);
+        ASSERT_EQ(a ^ a, BigUInt(0));
+        ASSERT_EQ(a & ~a, BigUInt(0));
+    }
+    EXPECT_EQ((BigUInt("0xF0F0") & BigUInt("0x0FF0")).toHex(), "F0");
+    EXPECT_EQ((BigUInt("0xF000000000000000F") | BigUInt(1)).toHex(), "F000000000000000F");
+    EXPECT_EQ((~BigUInt("0xFFFFFFFF00000000")).toHex(), "FFFFFFFF");
+}
+
+TEST_F(BigUIntTest, BitOps_CountBits) {
+    BigUInt a("0x10000000000000000");
+    EXPECT_EQ(a.bitLength(), 65);
+    EXPECT_EQ(a.countTrailingZeros(), 64);
+    EXPECT_EQ(a.popcount(), 1);
+    EXPECT_EQ(BigUInt("0xF0F0").popcount(), 8);
+    EXPECT_EQ(BigUInt("0xF0F0").countTrailingZeros(), 4);
+    EXPECT_EQ(BigUInt(0).bitLength(), 0);
+    EXPECT_EQ(BigUInt(0).popcount(), 0);
+}
+
 TEST_F(BigUIntTest, BitOps_GetSetBit) {
     BigUInt a(0);
     a.setBit(0);
@@ -324,4 +399,507 @@ TEST_F(BigUIntTest, BitOps_GetSetBit) {
     a.setBit(10);
     EXPECT_EQ(a.getBit(10), true);
     EXPECT_EQ(a.getBit(9), false);
-}
\ No newline at end of file
+}
+
+TEST_F(BigUIntTest, CRT_TextbookRSA) {
+    // n = 61 * 53 = 3233, e = 17, d = 2753
+    CrtContext crt(BigUInt(61), BigUInt(53), BigUInt(2753));
+    EXPECT_EQ(crt.modulus().toDec(), "3233");
+    BigUInt c = BigUInt(65).powMod(BigUInt(17), BigUInt(3233));
+    EXPECT_EQ(c.toDec(), "2790");
+    EXPECT_EQ(crt.powMod(c).toDec(), "65");
+    EXPECT_EQ(crt.powMod(c, true).toDec(), "65");
+}
+
+TEST_F(BigUIntTest, CRT_MatchesPowMod_MultiPrime) {
+    std::vector<BigUInt> primes = {
+        BigUInt("2147483647"),
+        BigUInt("2305843009213693951"),
+        BigUInt("618970019642690137449562111")
+    };
+    BigUInt n = primes[0] * primes[1] * primes[2];
+    for (int i = 0; i < 10; ++i) {
+        BigUInt d(randomHex(30));
+        BigUInt x = BigUInt(randomHex(40)) % n;
+        CrtContext crt(primes, d);
+        EXPECT_EQ(crt.modulus(), n);
+        EXPECT_EQ(crt.powMod(x, i % 2 == 0), x.powMod(d, n));
+    }
+}
+
+TEST_F(BigUIntTest, CRT_BaseSharesFactor) {
+    // 4 = 0 (mod 5 - 1), and 5 divides the base
+    EXPECT_EQ(CrtContext(BigUInt(5), BigUInt(7), BigUInt(4)).powMod(BigUInt(5)).toDec(), "30");
+    EXPECT_EQ(CrtContext(BigUInt(5), BigUInt(7), BigUInt(0)).powMod(BigUInt(5)).toDec(), "1");
+
+    BigUInt p("2305843009213693951"), q("618970019642690137449562111");
+    BigUInt n = p * q;
+    std::vector<BigUInt> exponents = { p - BigUInt(1), (q - BigUInt(1)) * BigUInt(3), BigUInt(randomHex(30)) };
+    for (const BigUInt& d : exponents) {
+        CrtContext crt(p, q, d);
+        for (const BigUInt& x : { p * BigUInt(12345), q * BigUInt(7), BigUInt(0), BigUInt(randomHex(20)) }) {
+            EXPECT_EQ(crt.powMod(x), x.powMod(d, n));
+        }
+    }
+}
+
+TEST_F(BigUIntTest, CRT_NonCoprimeFactors) {
+    EXPECT_THROW(CrtContext(BigUInt(15), BigUInt(25), BigUInt(3)), std::runtime_error);
+}
+
+TEST_F(BigUIntTest, Bytes_RoundTrip) {
+    for (int i = 0; i < 20; ++i) {
+        BigUInt a(randomHex(1 + rng() % 60));
+        EXPECT_EQ(BigUInt::fromBytes(a.toBytes()), a);
+        EXPECT_EQ(BigUInt::fromBytes(a.toBytes(BigUInt::ByteOrder::LittleEndian), BigUInt::ByteOrder::LittleEndian), a);
+    }
+}
+
+TEST_F(BigUIntTest, Bytes_ByteOrderAndPadding) {
+    BigUInt a("0x0102030405");
+    EXPECT_EQ(a.byteLength(), 5u);
+    EXPECT_EQ(a.toBytes(), (std::vector<uint8_t>{ 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(a.toBytes(BigUInt::ByteOrder::LittleEndian), (std::vector<uint8_t>{ 5, 4, 3, 2, 1 }));
+    EXPECT_EQ(a.toBytes(BigUInt::ByteOrder::BigEndian, 8), (std::vector<uint8_t>{ 0, 0, 0, 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(BigUInt(0).toBytes(), (std::vector<uint8_t>{ 0 }));
+    EXPECT_THROW(a.toBytes(BigUInt::ByteOrder::BigEndian, 4), std::runtime_error);
+}
+
+TEST_F(BigUIntTest, Bytes_MappedArrayRoundTrip) {
+    std::vector<BigUInt> values;
+    for (int i = 0; i < 25; ++i) values.push_back(BigUInt(randomHex(1 + rng() % 70)));
+    values.push_back(BigUInt(0));
+
+    std::string path = ::testing::TempDir() + "biguint_array_test.bin";
+    BigUIntArray::write(path, values);
+    {
+        MappedBigUIntArray arr(path);
+        ASSERT_EQ(arr.size(), values.size());
+        size_t i = 0;
+        for (std::span<const uint32_t> w : arr) {
+            EXPECT_EQ(BigUInt::fromWords(w), values[i]);
+            EXPECT_EQ(arr.at(i), values[i]);
+            ++i;
+        }
+        EXPECT_THROW(arr.words(values.size()), std::out_of_range);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(BigUIntTest, Bytes_MappedArrayRejectsCorruptHeader) {
+    std::string path = ::testing::TempDir() + "biguint_array_corrupt.bin";
+    auto patch = [&](std::streamoff offset, uint64_t value) {
+        BigUIntArray::write(path, std::vector<BigUInt>{ BigUInt(7), BigUInt(randomHex(30)) });
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (offset < 0) f.seekp(offset, std::ios::end);
+        else f.seekp(offset);
+        f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+
+    patch(16, UINT64_MAX);          // count + 1 wraps to 0
+    EXPECT_THROW(MappedBigUIntArray arr(path), std::runtime_error);
+    patch(16, 3);                   // index shorter than count + 1 entries
+    EXPECT_THROW(MappedBigUIntArray arr(path), std::runtime_error);
+    patch(-8, (1ULL << 62) + 1);    // end offset wraps to 4 bytes when scaled
+    EXPECT_THROW(MappedBigUIntArray arr(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST_F(BigUIntTest, ModOps_MulSqrMatchGeneric) {
+    for (int i = 0; i < 50; ++i) {
+        BigUInt n(randomHex(1 + rng() % 40));
+        BigUInt a(randomHex(1 + rng() % 50));
+        BigUInt b(randomHex(1 + rng() % 50));
+        ASSERT_EQ(BigUInt::mulMod(a, b, n), (a * b) % n) << "N=" << n.toHex();
+        ASSERT_EQ(BigUInt::sqrMod(a, n), (a * a) % n) << "N=" << n.toHex();
+    }
+}
+
+TEST_F(BigUIntTest, ModOps_AddSub) {
+    for (int i = 0; i < 50; ++i) {
+        BigUInt n(randomHex(1 + rng() % 30));
+        BigUInt a(randomHex(1 + rng() % 40));
+        BigUInt b(randomHex(1 + rng() % 40));
+        BigUInt ra = a % n, rb = b % n;
+        ASSERT_EQ(BigUInt::addMod(a, b, n), (a + b) % n);
+        BigUInt expected = (ra >= rb) ? ra - rb : (ra + n) - rb;
+        ASSERT_EQ(BigUInt::subMod(a, b, n), expected);
+    }
+    EXPECT_THROW(BigUInt::mulMod(BigUInt(3), BigUInt(4), BigUInt(0)), std::runtime_error);
+}
+
+TEST_F(BigUIntTest, ModOps_MulAdd) {
+    BigUInt a(randomHex(40)), b(randomHex(35)), c(randomHex(90));
+    EXPECT_EQ(BigUInt::mulAdd(a, b, c), a * b + c);
+    EXPECT_EQ(BigUInt::mulAdd(a, BigUInt(0), c), c);
+    BigUInt max("0xFFFFFFFFFFFFFFFF");
+    EXPECT_EQ(BigUInt::mulAdd(max, max, max), max * max + max);
+}
+
+TEST_F(BigUIntTest, ModInt_ArithmeticMatchesBigUInt) {
+    for (int i = 0; i < 30; ++i) {
+        std::string sN = randomHex(1 + rng() % 40);
+        BigUInt N(sN);
+        N.setBit(0);
+        if (N == BigUInt(1)) continue;
+        auto ctx = MontgomeryContext::create(N);
+
+        BigUInt a(randomHex(1 + rng() % 50)), b(randomHex(1 + rng() % 50));
+        ModInt x(ctx, a), y(ctx, b);
+        ASSERT_EQ(x.toBigUInt(), a % N);
+        ASSERT_EQ((x * y).toBigUInt(), (a * b) % N) << "N=" << N.toHex();
+        ASSERT_EQ((x + y).toBigUInt(), BigUInt::addMod(a, b, N));
+        ASSERT_EQ((x - y).toBigUInt(), BigUInt::subMod(a, b, N));
+    }
+}
+
+TEST_F(BigUIntTest, ModInt_ChainAndPow) {
+    BigUInt N("0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1");
+    auto ctx = MontgomeryContext::create(N);
+    BigUInt a(randomHex(60)), e(randomHex(40));
+
+    ModInt acc(ctx, BigUInt(1));
+    ModInt x(ctx, a);
+    BigUInt expected(1);
+    for (int i = 0; i < 20; ++i) {
+        acc = acc * x + x;
+        expected = BigUInt::addMod(BigUInt::mulMod(expected, a, N), a, N);
+    }
+    EXPECT_EQ(acc.toBigUInt(), expected);
+    EXPECT_EQ(x.pow(e).toBigUInt(), a.powMod(e, N));
+    EXPECT_EQ(x.pow(BigUInt(0)).toDec(), "1");
+}
+
+TEST_F(BigUIntTest, ModInt_InvalidModulus) {
+    EXPECT_THROW(MontgomeryContext::create(BigUInt(100)), std::runtime_error);
+    ModInt a(BigUInt(101), BigUInt(5));
+    ModInt b(BigUInt(103), BigUInt(5));
+    EXPECT_THROW(a + b, std::runtime_error);
+}
+
+TEST_F(BigUIntTest, FixedBase_MatchesPowMod) {
+    BigUInt N("0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1");
+    BigUInt g(randomHex(50));
+    int layouts[][2] = { { 1, 1 }, { 4, 1 }, { 4, 3 }, { 6, 2 }, { 5, 200 } };
+    for (auto& l : layouts) {
+        FixedBasePow fb(g, N, 160, l[0], l[1]);
+        for (int i = 0; i < 5; ++i) {
+            BigUInt e(randomHex(1 + rng() % 40));
+            ASSERT_EQ(fb.pow(e), g.powMod(e, N)) << "teeth=" << l[0] << " subTables=" << l[1];
+        }
+        EXPECT_EQ(fb.pow(BigUInt(0)).toDec(), "1");
+    }
+}
+
+TEST_F(BigUIntTest, FixedBase_LongExponentFallsBack) {
+    BigUInt N("1000000007");
+    FixedBasePow fb(BigUInt(5), N, 16);
+    BigUInt e(randomHex(30));
+    EXPECT_EQ(fb.pow(e), BigUInt(5).powMod(e, N));
+}
+
+TEST_F(BigUIntTest, FixedBase_SaveLoad) {
+    BigUInt N("0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1");
+    FixedBasePow fb(BigUInt(7), N, 256, 5, 3);
+    std::stringstream ss;
+    fb.save(ss);
+    FixedBasePow loaded = FixedBasePow::load(ss);
+    EXPECT_EQ(loaded.tableBytes(), fb.tableBytes());
+    for (int i = 0; i < 5; ++i) {
+        BigUInt e(randomHex(64));
+        ASSERT_EQ(loaded.pow(e), fb.pow(e));
+    }
+    std::stringstream bad("not a table");
+    EXPECT_THROW(FixedBasePow::load(bad), std::runtime_error);
+}
+
+TEST_F(BigUIntTest, FixedBase_LoadRejectsForgedHeader) {
+    FixedBasePow fb(BigUInt(7), BigUInt("0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1"), 64, 4, 2);
+    std::stringstream ss;
+    fb.save(ss);
+    std::string saved = ss.str();
+    auto patchU32 = [](std::string& s, size_t offset, uint32_t x) {
+        for (int i = 0; i < 4; ++i) s[offset + i] = static_cast<char>(x >> (8 * i));
+    };
+
+    // 2^30-bit exponents with 16 teeth and 1024 sub-tables: gigabytes of table.
+    std::string forged = saved;
+    patchU32(forged, 8, 1u << 30);
+    patchU32(forged, 12, 16);
+    patchU32(forged, 16, 1024);
+    std::stringstream big(forged);
+    EXPECT_THROW(FixedBasePow::load(big), std::runtime_error);
+
+    std::stringstream truncated(saved.substr(0, saved.size() - 4));
+    EXPECT_THROW(FixedBasePow::load(truncated), std::runtime_error);
+}
+
+TEST_F(BigUIntTest, Product_MatchesSequential) {
+    std::vector<BigUInt> values;
+    BigUInt expected(1);
+    for (int i = 0; i < 37; ++i) {
+        values.push_back(BigUInt(randomHex(1 + rng() % 200)));
+        expected = expected * values.back();
+    }
+    EXPECT_EQ(BigUInt::product(values), expected);
+    EXPECT_EQ(BigUInt::product(std::span<const BigUInt>()), BigUInt(1));
+    values.push_back(BigUInt(0));
+    EXPECT_EQ(BigUInt::product(values), BigUInt(0));
+}
+
+TEST_F(BigUIntTest, Product_KaratsubaSizes) {
+    for (int i = 0; i < 10; ++i) {
+        BigUInt a(randomHex(400 + rng() % 2000));
+        BigUInt b(randomHex(400 + rng() % 2000));
+        BigUInt c(randomHex(30));
+        BigUInt p = a * b;
+        EXPECT_EQ(p % b, BigUInt(0));
+        EXPECT_EQ((a * (b + c)), p + a * c);
+    }
+}
+
+TEST_F(BigUIntTest, Product_ParallelKaratsuba) {
+    // 2^18-bit operands split into halves above the threading threshold.
+    BigUInt a(randomHex(1 << 16)), b(randomHex(1 << 16) + "1");
+    BigUInt serial = a * b;
+    spareThreads().fetch_add(2);    // lend threads even on a single-core host
+    BigUInt threaded = a * b;
+    spareThreads().fetch_sub(2);
+    EXPECT_EQ(threaded, serial);
+    BigUInt p("618970019642690137449562111");
+    EXPECT_EQ(threaded % p, BigUInt::mulMod(a % p, b % p, p));
+}
+
+TEST_F(BigUIntTest, Product_Factorial) {
+    EXPECT_EQ(BigUInt::factorial(0).toDec(), "1");
+    EXPECT_EQ(BigUInt::factorial(1).toDec(), "1");
+    EXPECT_EQ(BigUInt::factorial(20).toDec(), "2432902008176640000");
+    EXPECT_EQ(BigUInt::factorial(30).toDec(), "265252859812191058636308480000000");
+    BigUInt f(1);
+    for (uint32_t i = 2; i <= 300; ++i) f = f * BigUInt(i);
+    EXPECT_EQ(BigUInt::factorial(300), f);
+}
+
+TEST_F(BigUIntTest, Product_Binomial) {
+    EXPECT_EQ(BigUInt::binomial(5, 2).toDec(), "10");
+    EXPECT_EQ(BigUInt::binomial(10, 0).toDec(), "1");
+    EXPECT_EQ(BigUInt::binomial(3, 5).toDec(), "0");
+    EXPECT_EQ(BigUInt::binomial(100, 50).toDec(), "100891344545564193334812497256");
+    EXPECT_EQ(BigUInt::binomial(200, 73), BigUInt::factorial(200) / (BigUInt::factorial(73) * BigUInt::factorial(127)));
+}
+
+TEST_F(BigUIntTest, BatchGcd_FindsSharedFactors) {
+    BigUInt p1("2147483647"), p2("2305843009213693951"), p3("618970019642690137449562111");
+    BigUInt p4("170141183460469231731687303715884105727"), p5("1000000007"), p6("998244353");
+    std::vector<BigUInt> moduli = { p1 * p2, p3 * p4, p5 * p2, p6 * BigUInt(65537), p3 * BigUInt(3) };
+
+    std::vector<BigUInt> g = batchGcd(moduli);
+    ASSERT_EQ(g.size(), moduli.size());
+    EXPECT_EQ(g[0], p2);
+    EXPECT_EQ(g[1], p3);
+    EXPECT_EQ(g[2], p2);
+    EXPECT_EQ(g[3], BigUInt(1));
+    EXPECT_EQ(g[4], p3);
+}
+
+TEST_F(BigUIntTest, BatchGcd_MatchesPairwise) {
+    std::vector<BigUInt> moduli;
+    for (int i = 0; i < 13; ++i) moduli.push_back(BigUInt(randomHex(1 + rng() % 20)));
+    std::vector<BigUInt> g = batchGcd(moduli);
+    for (size_t i = 0; i < moduli.size(); ++i) {
+        BigUInt others(1);
+        for (size_t j = 0; j < moduli.size(); ++j) if (j != i) others = others * moduli[j];
+        ASSERT_EQ(g[i], BigUInt::gcd(moduli[i], others)) << "i=" << i;
+    }
+}
+
+TEST_F(BigUIntTest, BatchGcd_FromMappedArray) {
+    std::vector<BigUInt> moduli = { BigUInt(15), BigUInt(77), BigUInt(21), BigUInt(143) };
+    std::string path = ::testing::TempDir() + "batch_gcd_test.bin";
+    BigUIntArray::write(path, moduli);
+    {
+        MappedBigUIntArray arr(path);
+        std::vector<BigUInt> g = batchGcd(arr);
+        EXPECT_EQ(g, (std::vector<BigUInt>{ BigUInt(3), BigUInt(77), BigUInt(21), BigUInt(11) }));
+    }
+    std::remove(path.c_str());
+    EXPECT_TRUE(batchGcd(std::vector<BigUInt>()).empty());
+}
+
+TEST_F(BigUIntTest, Cache_HitsAndMisses) {
+    ReductionCache cache(16);
+    BigUInt n1(randomHex(40)), n2(randomHex(40));
+    n1.setBit(0);
+
+    auto c1 = cache.get(n1);
+    EXPECT_EQ(cache.misses(), 1u);
+    EXPECT_EQ(cache.get(n1), c1);
+    EXPECT_EQ(cache.hits(), 1u);
+    EXPECT_EQ(c1->modulus, n1);
+    ASSERT_NE(c1->montgomery, nullptr);
+
+    BigUInt x(randomHex(70));
+    EXPECT_EQ(c1->barrett().reduce(x), x % n1);
+
+    n2.setBit(0);
+    n2 = n2 + BigUInt(1);
+    auto c2 = cache.get(n2);
+    EXPECT_EQ(c2->montgomery, nullptr);
+    EXPECT_EQ(cache.misses(), 2u);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST_F(BigUIntTest, Cache_EvictsWhenFull) {
+    ReductionCache cache(ReductionCache::WAYS);
+    std::vector<BigUInt> moduli;
+    for (int i = 0; i < 40; ++i) moduli.push_back(BigUInt(randomHex(20)));
+    for (const BigUInt& n : moduli) cache.get(n);
+    EXPECT_EQ(cache.size(), cache.capacity());
+
+    // The most recent moduli are still resident.
+    uint64_t before = cache.hits();
+    cache.get(moduli.back());
+    EXPECT_EQ(cache.hits(), before + 1);
+}
+
+TEST_F(BigUIntTest, Cache_ConcurrentEviction) {
+    // One set, four times more moduli than ways: hits race with evictions.
+    ReductionCache cache(ReductionCache::WAYS);
+    std::vector<BigUInt> moduli;
+    for (int i = 0; i < 32; ++i) moduli.push_back(BigUInt(randomHex(16)));
+
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{ 0 };
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                const BigUInt& n = moduli[(i * 7 + t * 3 + (i / 64)) % moduli.size()];
+                if (cache.get(n)->modulus != n) ++failures;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(cache.hits() + cache.misses(), 8000u);
+    EXPECT_EQ(cache.size(), cache.capacity());
+}
+
+TEST_F(BigUIntTest, Cache_ConcurrentPowMod) {
+    std::vector<BigUInt> moduli, bases;
+    for (int i = 0; i < 4; ++i) {
+        BigUInt n(randomHex(64));
+        n.setBit(0);
+        moduli.push_back(n);
+        bases.push_back(BigUInt(randomHex(60)));
+    }
+    BigUInt e(randomHex(20));
+    std::vector<BigUInt> expected;
+    // Reference by plain square-and-multiply, which never touches the cache.
+    for (int i = 0; i < 4; ++i) {
+        BigUInt r(1), b = bases[i] % moduli[i];
+        for (int bit = 0; bit < e.bitLength(); ++bit) {
+            if (e.getBit(bit)) r = BigUInt::mulMod(r, b, moduli[i]);
+            b = BigUInt::sqrMod(b, moduli[i]);
+        }
+        expected.push_back(r);
+    }
+
+    std::vector<std::thread> threads;
+    std::atomic<int> failures{ 0 };
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 20; ++i) {
+                int k = (t + i) % 4;
+                if (bases[k].powMod(e, moduli[k]) != expected[k]) ++failures;
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(failures.load(), 0);
+}
+
+TEST_F(BigUIntTest, Special_Detection) {
+    BigUInt one(1);
+    auto m521 = PseudoMersenneContext::detect((one << 521) - one);
+    ASSERT_NE(m521, nullptr);
+    EXPECT_EQ(m521->bits(), 521);
+    EXPECT_EQ(m521->offset(), one);
+
+    auto p25519 = PseudoMersenneContext::detect((one << 255) - BigUInt(19));
+    ASSERT_NE(p25519, nullptr);
+    EXPECT_EQ(p25519->offset(), BigUInt(19));
+    EXPECT_NE(PseudoMersenneContext::detect((one << 512) - BigUInt(15)), nullptr);
+    EXPECT_NE(PseudoMersenneContext::detect((one << 80) - BigUInt("0xFFFFFFFFFF")), nullptr);
+
+    EXPECT_EQ(PseudoMersenneContext::detect(BigUInt("0xFFFFFFFB")), nullptr);
+    EXPECT_EQ(PseudoMersenneContext::detect((one << 256) - (one << 200)), nullptr);
+    for (int i = 0; i < 5; ++i) EXPECT_EQ(PseudoMersenneContext::detect(BigUInt(randomHex(64))), nullptr);
+
+    auto ctx = ReductionCache::global().get((one << 127) - one);
+    EXPECT_NE(ctx->special, nullptr);
+}
+
+TEST_F(BigUIntTest, Special_WordTestIsExact) {
+    BigUInt one(1);
+    for (int k = 33; k <= 200; k += 7) {
+        int h = k / 2;
+        std::vector<BigUInt> offsets = { one, (one << h) - one, one << h, (one << h) + one, BigUInt(randomHex(h / 4)) + one };
+        for (const BigUInt& c : offsets) {
+            BigUInt n = (one << k) - c;
+            bool expected = c.bitLength() <= h;
+            EXPECT_EQ(PseudoMersenneContext::hasSpecialForm(n.words()), expected) << k << " " << c.toHex();
+            EXPECT_EQ(PseudoMersenneContext::detect(n) != nullptr, expected);
+        }
+    }
+    // Top words of the form 2^j - 1 alone do not qualify.
+    EXPECT_FALSE(PseudoMersenneContext::hasSpecialForm(BigUInt("0x10000000F").words()));
+    EXPECT_FALSE(PseudoMersenneContext::hasSpecialForm(BigUInt("0x3123456789ABCDEF012345678").words()));
+}
+
+TEST_F(BigUIntTest, Special_MatchesGeneric) {
+    BigUInt one(1);
+    std::vector<std::shared_ptr<const PseudoMersenneContext>> contexts = {
+        PseudoMersenneContext::detect((one << 521) - one),
+        PseudoMersenneContext::detect((one << 255) - BigUInt(19)),
+        PseudoMersenneContext::detect((one << 512) - BigUInt(15)),
+        PseudoMersenneContext::create(256, BigUInt(randomHex(50))),
+    };
+    for (const auto& ctx : contexts) {
+        ASSERT_NE(ctx, nullptr);
+        const BigUInt& n = ctx->modulus();
+        for (int i = 0; i < 10; ++i) {
+            BigUInt a(randomHex(140)), b(randomHex(120));
+            EXPECT_EQ(ctx->reduce(a * b), (a * b) % n);
+            EXPECT_EQ(ctx->mulMod(a, b), (a % n) * (b % n) % n);
+        }
+        EXPECT_EQ(ctx->reduce(n), BigUInt(0));
+        EXPECT_EQ(ctx->reduce(n - one), n - one);
+
+        BigUInt base(randomHex(100)), e(randomHex(40));
+        BigUInt expected(1), b = base % n;
+        for (int i = 0; i < e.bitLength(); ++i) {
+            if (e.getBit(i)) expected = expected * b % n;
+            b = b * b % n;
+        }
+        EXPECT_EQ(ctx->powMod(base, e), expected);
+        EXPECT_EQ(base.powMod(e, n), expected);
+        EXPECT_EQ(ctx->powMod(base, BigUInt(0)), one);
+    }
+}
+
+TEST_F(BigUIntTest, Special_InvalidOffset) {
+    EXPECT_THROW(PseudoMersenneContext(64, BigUInt(0)), std::runtime_error);
+    EXPECT_THROW(PseudoMersenneContext(64, BigUInt(1) << 63), std::runtime_error);
+    EXPECT_THROW(PseudoMersenneContext(1, BigUInt(1)), std::runtime_error);
+
+    // Boundaries of 0 < c < 2^(k-1): the largest offsets still fold correctly.
+    for (const BigUInt& c : { BigUInt(1) << 62, (BigUInt(1) << 63) - BigUInt(1) }) {
+        PseudoMersenneContext ctx(64, c);
+        BigUInt x(randomHex(40));
+        EXPECT_EQ(ctx.reduce(x), x % ctx.modulus());
+        EXPECT_EQ(ctx.mulMod(x, x), x * x % ctx.modulus());
+    }
+    PseudoMersenneContext three(2, BigUInt(1));
+    EXPECT_EQ(three.reduce(BigUInt(100)), BigUInt(1));
+    EXPECT_EQ(three.powMod(BigUInt(2), BigUInt(5)), BigUInt(2));
+}